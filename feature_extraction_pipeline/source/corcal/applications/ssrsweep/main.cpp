@@ -0,0 +1,111 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::applications::ssrsweep
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+// STD/STL
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+namespace fs = std::filesystem;
+
+// JSON
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+// corcal
+#include <corcal/core/ssr.h>
+#include <corcal/core/ssr/json.h>
+using namespace corcal::core;
+
+
+namespace
+{
+    std::string
+    threshold_to_string(double threshold)
+    {
+        std::ostringstream ss;
+        ss << threshold;
+        return ss.str();
+    }
+}
+
+
+/**
+ * Offline sweep over distance equality thresholds.  Reads the 3D object frames (frame_<n>.json) cnnreplay wrote to
+ * its 3d_objects directory, and writes the spatial relations of each frame for each threshold to
+ * <output directory>/spatial_relations_<threshold>/frame_<n>.json, in the same format as cnnreplay.  Each frame is
+ * evaluated for all thresholds in a single pass.
+ */
+int
+main(int argc, char* argv[])
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <3d_objects directory> <output directory> <threshold> [<threshold>...]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const fs::path objects_path{argv[1]};
+    const fs::path out_path{argv[2]};
+
+    std::vector<double> thresholds;
+    std::vector<fs::path> thresholds_out_paths;
+    for (int arg = 3; arg < argc; ++arg)
+    {
+        thresholds.push_back(std::stod(argv[arg]));
+        thresholds_out_paths.push_back(out_path / ("spatial_relations_" + ::threshold_to_string(thresholds.back())));
+        fs::create_directories(thresholds_out_paths.back());
+    }
+
+    unsigned int frame = 0;
+    for (;; ++frame)
+    {
+        const fs::path filename{"frame_" + std::to_string(frame) + ".json"};
+        const fs::path objects_frame_path = objects_path / filename;
+        if (not fs::is_regular_file(objects_frame_path))
+            break;
+
+        std::ifstream objects_frame_file{objects_frame_path.string()};
+        json objects_frame_json;
+        objects_frame_file >> objects_frame_json;
+        const std::vector<detected_object> objects = objects_frame_json;
+
+        const std::vector<ssr::ssr_matrix> ssr_matrices = ssr::evaluate_relations_thresholds(objects, thresholds);
+
+        for (std::size_t k = 0; k < thresholds.size(); ++k)
+        {
+            std::ofstream o{(thresholds_out_paths[k] / filename).string()};
+            o << std::setw(4) << ssr::relations_to_json(ssr_matrices[k]) << std::endl;
+        }
+    }
+
+    std::cout << "Evaluated " << frame << " frames for " << thresholds.size() << " thresholds." << std::endl;
+
+    return EXIT_SUCCESS;
+}
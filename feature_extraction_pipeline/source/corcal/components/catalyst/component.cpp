@@ -51,6 +51,12 @@ namespace fs = std::filesystem;
 #include <pcl/segmentation/sac_segmentation.h>
 #include <pcl/segmentation/extract_clusters.h>
 
+// Boost
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/lexical_cast.hpp>
+
 // JSON
 #include <nlohmann/json.hpp>
 using json = nlohmann::json;
@@ -170,6 +176,37 @@ component::onInitImageProcessor()
         m_ignore_cnns = true;
     }
 
+    // Horizons of the past bounding boxes.
+    {
+        const std::string past_horizons = getProperty<std::string>("past_horizons");
+        m_past_horizons.clear();
+        if (not past_horizons.empty())
+        {
+            std::vector<std::string> split;
+            boost::algorithm::split(split, past_horizons, boost::is_any_of(","));
+            for (const std::string& horizon : split)
+            {
+                m_past_horizons.emplace_back(boost::lexical_cast<int>(boost::algorithm::trim_copy(horizon)));
+                ARMARX_CHECK_GREATER_EQUAL(m_past_horizons.back().count(), 0);
+            }
+        }
+    }
+
+    // Bounding box smoothing.
+    {
+        const int bounding_box_smoothing = getProperty<int>("bounding_box_smoothing");
+        if (bounding_box_smoothing > 0)
+        {
+            m_bounding_box_smoother = std::make_unique<corcal::core::bounding_box_smoother>(
+                ch::milliseconds{bounding_box_smoothing},
+                getProperty<corcal::core::smoothing_kernel>("bounding_box_smoothing_kernel").getValue());
+        }
+        else
+        {
+            m_bounding_box_smoother.reset();
+        }
+    }
+
     // Initialise working memory.
     {
         const float initial_certainty = getProperty<float>("memory_initial_certainty");
@@ -177,6 +214,9 @@ component::onInitImageProcessor()
             getProperty<int>("memory_remember_duration").getValue()};
         m_memory.initial_certainty_threshold(initial_certainty);
         m_memory.remember_duration(remember_duration);
+        const float gating_distance = getProperty<float>("memory_match_gating_distance");
+        m_memory.match_gating_distance(gating_distance < 0 ? std::numeric_limits<double>::infinity()
+                                                           : static_cast<double>(gating_distance));
     }
 
     // Signal dependency on the object detection and pose estimation topics.
@@ -368,7 +408,7 @@ component::run_input_synchronisation()
                 preprocessed_objects,
                 input_image_detected_objects, timestamp_last_detected_objects,
                 input_image_hand_pose, timestamp_last_hand_pose,
-                ch::milliseconds{std::max(getProperty<int>("bounding_box_smoothing").getValue(), 0)}
+                m_bounding_box_smoother.get()
             );
             // Don't use any buffer from this point on, they may be in an invalid state by then.
             signal_lock.unlock();
@@ -549,7 +589,7 @@ component::reportDetectedObjects(
         m_memory.now(m_timestamp_last_detected_objects);
     }
     m_memory.make_observations(functions::cvt_to_corcal_observations(
-        detected_objects, m_timestamp_last_detected_objects));
+        detected_objects, m_timestamp_last_detected_objects, m_memory.pool()));
 
     m_proc_signal.notify_one();
 }
@@ -570,7 +610,7 @@ component::report2DHandKeypointsNormalized(
         m_memory.now(m_timestamp_last_hand_pose);
     }
     m_memory.make_observations(
-        functions::cvt_to_corcal_observations(hand_pose_2d, m_timestamp_last_hand_pose));
+        functions::cvt_to_corcal_observations(hand_pose_2d, m_timestamp_last_hand_pose, m_memory.pool()));
     m_hand_pose_buffer = hand_pose_2d;
 
     m_proc_signal.notify_one();
@@ -717,7 +757,7 @@ component::process_inputs(
     const ch::microseconds& detected_objects_timestamp,
     ::CByteImage** input_image_hand_pose,
     const ch::microseconds& hand_pose_timestamp,
-    const ch::milliseconds& bounding_box_smoothing) const
+    const corcal::core::bounding_box_smoother* bounding_box_smoother) const
 {
     pcl::PointCloud<pcl::PointXYZ>::Ptr darknet_pointcloud{}, openpose_pointcloud{};
     float table_orl = 0;
@@ -910,6 +950,9 @@ component::process_inputs(
 
     std::vector<corcal::core::detected_object> conv_objects;
 
+    std::vector<ch::milliseconds> past_horizons = m_past_horizons;
+    past_horizons.push_back(corcal::core::known_object::default_past_horizon);
+
     ARMARX_DEBUG << "Estimating depth and converting to interface types";
     {
         const auto start_time = ch::high_resolution_clock::now();
@@ -950,13 +993,13 @@ component::process_inputs(
             }
 
             // Now that it is certain that the bounding box is valid, save it for later reference.
-            if (bounding_box_smoothing != ch::milliseconds::zero())
+            if (bounding_box_smoother)
             {
                 ARMARX_DEBUG << "Smoothing bounding boxes now.";
                 vx::BoundingBox3D smoothed_bounding_box = known_object->average_bounding_boxes(
                     bounding_box,
                     observation->seen_at(),
-                    bounding_box_smoothing
+                    *bounding_box_smoother
                 );
                 bounding_box = smoothed_bounding_box;
             }
@@ -965,16 +1008,22 @@ component::process_inputs(
                 ARMARX_DEBUG << "Using raw bounding box, skipping smoothing.";
             }
 
-            observation->bounding_box(bounding_box);
+            known_object->current_bounding_box(bounding_box);
 
             ARMARX_CHECK_LESS_EQUAL(bounding_box.x0, bounding_box.x1);
             ARMARX_CHECK_LESS_EQUAL(bounding_box.y0, bounding_box.y1);
             ARMARX_CHECK_LESS_EQUAL(bounding_box.z0, bounding_box.z1);
 
+            // Past bounding boxes from the history for all configured horizons and the default one (last).
+            const std::vector<vx::BoundingBox3D> past_bounding_boxes
+                = known_object->past_bounding_boxes(past_horizons);
+
             corcal::core::detected_object conv_object;
             corcal::core::candidate candidate = observation->candidates().at(0);
             conv_object.bounding_box = bounding_box;
-            conv_object.past_bounding_box = known_object->past_observation()->bounding_box();
+            conv_object.past_bounding_box = past_bounding_boxes.back();
+            for (std::size_t i = 0; i < m_past_horizons.size(); ++i)
+                conv_object.past_bounding_boxes.push_back(past_bounding_boxes[i]);
             conv_object.certainty = candidate.certainty();
             conv_object.class_index = candidate.class_index();
             conv_object.class_name = candidate.class_name();
@@ -1037,6 +1086,12 @@ component::createPropertyDefinitions()
         "Minimum initial certainty for new objects to be recognised as such (and not be discarded "
         "as noise).  Doesn't affect subsequent observations of known objects."
     ).setMin(0.0).setMax(1.0);
+    defs->defineOptionalProperty<float>(
+        "memory_match_gating_distance",
+        -1,
+        "Maximum distance between the centres of an observation and the last observation of a known "
+        "object in normalised image coordinates for them to be matched.  Negative: no limit."
+    );
     defs->defineOptionalProperty<int>(
         "memory_remember_duration",
         750,
@@ -1049,6 +1104,21 @@ component::createPropertyDefinitions()
         "Time in [ms] for the last bounding boxes considered for smoothing (averaging).  Negative"
         "values: don't smooth."
     );
+    defs->defineOptionalProperty<corcal::core::smoothing_kernel>(
+        "bounding_box_smoothing_kernel",
+        corcal::core::smoothing_kernel::gaussian,
+        "Kernel weighting the last bounding boxes by their age when smoothing.  With gaussian, 3σ equals "
+        "bounding_box_smoothing.  With exponential, the time constant is a third of bounding_box_smoothing, and the "
+        "weighted sums are updated recursively instead of over all bounding boxes within bounding_box_smoothing."
+    )
+    .map("gaussian", corcal::core::smoothing_kernel::gaussian)
+    .map("exponential", corcal::core::smoothing_kernel::exponential);
+    defs->defineOptionalProperty<std::string>(
+        "past_horizons",
+        "",
+        "Comma separated look-backs in [ms], e.g. \"100,333,1000\", at which past bounding boxes are exported in "
+        "addition to past_bounding_box (333 ms).  Limited by memory_remember_duration.  Empty: none."
+    );
     defs->defineOptionalProperty<int>(
         "long_term_image_buffer_size",
         30,
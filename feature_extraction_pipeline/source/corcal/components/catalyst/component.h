@@ -25,8 +25,10 @@
 
 
 // STD/STL
+#include <chrono>
 #include <condition_variable>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -79,6 +81,16 @@ class component :
 
         bool m_use_manual_timestamps;
 
+        /**
+         * @brief Horizons at which past bounding boxes are exported in detected_object::past_bounding_boxes
+         */
+        std::vector<std::chrono::milliseconds> m_past_horizons;
+
+        /**
+         * @brief Smoother of the bounding boxes of the known objects, if bounding_box_smoothing is positive
+         */
+        std::unique_ptr<corcal::core::bounding_box_smoother> m_bounding_box_smoother;
+
         // Mutexes and synchronisation
         std::mutex m_input_proc_mutex;
         std::condition_variable m_proc_signal;
@@ -193,7 +205,7 @@ class component :
             const std::chrono::microseconds& detected_objects_timestamp,
             ::CByteImage** input_image_hand_pose,
             const std::chrono::microseconds& hand_pose_timestamp,
-            const std::chrono::milliseconds& bounding_box_smoothing
+            const corcal::core::bounding_box_smoother* bounding_box_smoother
         ) const;
 
         armarx::PropertyDefinitionsPtr
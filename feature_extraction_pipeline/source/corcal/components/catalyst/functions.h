@@ -53,13 +53,15 @@ namespace corcal::components::catalyst::functions
 std::vector<corcal::core::observation::ptr>
 cvt_to_corcal_observations(
     const std::vector<visionx::yolo::DetectedObject>& dol,
-    const std::chrono::microseconds& timestamp);
+    const std::chrono::microseconds& timestamp,
+    corcal::core::observation_pool& pool);
 
 
 std::vector<corcal::core::observation::ptr>
 cvt_to_corcal_observations(
     const armarx::Keypoint2DMapList& kpml,
-    const std::chrono::microseconds& timestamp);
+    const std::chrono::microseconds& timestamp,
+    corcal::core::observation_pool& pool);
 
 
 pcl::PointCloud<pcl::PointXYZ>::Ptr
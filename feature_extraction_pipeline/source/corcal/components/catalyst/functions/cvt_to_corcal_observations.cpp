@@ -32,6 +32,9 @@
 // IVT
 #include <Image/ByteImage.h>
 
+// ArmarX
+#include <ArmarXCore/core/logging/Logging.h>
+
 // VisionX
 #include <VisionX/interface/components/OpenPoseEstimationInterface.h>
 #include <VisionX/interface/components/YoloObjectListener.h>
@@ -47,28 +50,33 @@ using namespace corcal::components::catalyst;
 std::vector<corcal::core::observation::ptr>
 functions::cvt_to_corcal_observations(
         const std::vector<visionx::yolo::DetectedObject>& detected_objects,
-        const std::chrono::microseconds& timestamp)
+        const std::chrono::microseconds& timestamp,
+        corcal::core::observation_pool& pool)
 {
     std::vector<corcal::core::observation::ptr> observations;
     observations.reserve(detected_objects.size());
 
     for (const visionx::yolo::DetectedObject& detected_object : detected_objects)
     {
-        corcal::core::observation::ptr observation = std::make_shared<corcal::core::observation>();
+        // Recycled observation, whose candidates are filled in place to reuse their storage
+        corcal::core::observation::ptr observation = pool.acquire();
 
         // Candidates
-        std::vector<corcal::core::candidate> candidates;
-        candidates.reserve(detected_object.candidates.size());
+        corcal::core::candidate_list& candidates = observation->candidates();
         for (const visionx::yolo::ClassCandidate& class_candidate : detected_object.candidates)
         {
-            corcal::core::candidate candidate;
+            if (not candidates.push_back(corcal::core::candidate{}))
+            {
+                ARMARX_WARNING << "Detected object has " << detected_object.candidates.size() << " class candidates, "
+                               << "only the first " << corcal::core::candidate_list::max_candidates << " are kept";
+                break;
+            }
+            corcal::core::candidate& candidate = candidates[candidates.size() - 1];
             candidate.certainty(class_candidate.certainty);
             candidate.class_index(class_candidate.classIndex);
             candidate.class_name(class_candidate.className);
             candidate.colour(class_candidate.color);
-            candidates.push_back(std::move(candidate));
         }
-        observation->candidates(std::move(candidates));
 
         // Adopt properties from VisionX data structure
         observation->class_count(detected_object.classCount);
@@ -94,7 +102,8 @@ functions::cvt_to_corcal_observations(
 std::vector<corcal::core::observation::ptr>
 functions::cvt_to_corcal_observations(
         const armarx::Keypoint2DMapList& keypoint_maps,
-        const std::chrono::microseconds& timestamp)
+        const std::chrono::microseconds& timestamp,
+        corcal::core::observation_pool& pool)
 {
     std::vector<visionx::yolo::DetectedObject> hands;
     hands.reserve(keypoint_maps.size() * 2);
@@ -188,5 +197,5 @@ functions::cvt_to_corcal_observations(
 
     hands.shrink_to_fit();
 
-    return functions::cvt_to_corcal_observations(std::move(hands), timestamp);
+    return functions::cvt_to_corcal_observations(std::move(hands), timestamp, pool);
 }
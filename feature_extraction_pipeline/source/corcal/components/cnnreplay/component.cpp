@@ -47,6 +47,7 @@ namespace vx = visionx;
 
 // corcal
 #include <corcal/core/ssr.h>
+#include <corcal/core/ssr/json.h>
 using namespace corcal::core;
 using namespace corcal::components::cnnreplay;
 
@@ -70,19 +71,6 @@ namespace armarx
 }
 namespace visionx
 {
-    void to_json(json& j, const visionx::BoundingBox3D bb)
-    {
-        j = json
-        {
-            {"x0", bb.x0},
-            {"y0", bb.y0},
-            {"z0", bb.z0},
-            {"x1", bb.x1},
-            {"y1", bb.y1},
-            {"z1", bb.z1}
-        };
-    }
-
     void from_json(const json& j, visionx::BoundingBox2D& bb)
     {
         j.at("x").get_to(bb.x);
@@ -109,22 +97,6 @@ namespace visionx::yolo
         j.at("bounding_box").get_to(det.boundingBox);
     }
 }
-namespace corcal::core
-{
-    void to_json(json& j, const detected_object& det)
-    {
-        j = json
-        {
-            {"class_name", det.class_name},
-            {"class_index", det.class_index},
-            {"instance_name", det.instance_name},
-            {"certainty", det.certainty},
-            {"bounding_box", det.bounding_box},
-            {"past_bounding_box", det.past_bounding_box},
-            {"colour", {det.colour.r, det.colour.g, det.colour.b}}
-        };
-    }
-}
 namespace
 {
     struct table_parameters
@@ -135,17 +107,6 @@ namespace
         double offset_d;
     };
 
-    struct relation
-    {
-        unsigned int subject_index;
-        unsigned int object_index;
-        std::string relation_name;
-
-        relation(unsigned int si, unsigned int oi, const std::string& rel) :
-            subject_index{si}, object_index{oi}, relation_name{rel}
-        {}
-    };
-
     void from_json(const json& j, ::table_parameters& tp)
     {
         j.at("angle").get_to(tp.angle);
@@ -153,16 +114,6 @@ namespace
         j.at("offset_h").get_to(tp.offset_h);
         j.at("offset_d").get_to(tp.offset_d);
     }
-
-    void to_json(json& j, const ::relation& r)
-    {
-        j = json
-        {
-            {"subject_index", r.subject_index},
-            {"object_index", r.object_index},
-            {"relation_name", r.relation_name}
-        };
-    }
 }
 
 
@@ -220,7 +171,10 @@ component::onInitCapturingImageProvider()
     }
 
     usingTopic("corcal_catalyst_3dobjects");
-    usingTopic("corcal_ssr_features");
+    if (getProperty<bool>("use_ssr_delta_topic"))
+        usingTopic(getProperty<std::string>("ssr_delta_topic"));
+    else
+        usingTopic("corcal_ssr_features");
 
     const int fixed_rec_index = getProperty<int>("replay_single_rec");
     if (fixed_rec_index >= 0)
@@ -519,34 +473,59 @@ component::ssr_features_detected(
 
     ARMARX_DEBUG << "Received SSR features.";
 
-    const std::vector<std::vector<relations>> ssr_matrix = unserialise(ssr_matrix_serialised);
-    const unsigned long dim = ssr_matrix.size();
+    process_ssr_features(objects, unserialise(ssr_matrix_serialised));
+}
 
-    ARMARX_DEBUG << "Received an " << dim << "x" << dim << " SSR features matrix.";
 
-    std::vector<::relation> rels;
+void
+component::ssr_delta_detected(const ssr_delta& delta, const Ice::Current&)
+{
+    const std::lock_guard<std::mutex> lock{m_proc_mutex};
+
+    ARMARX_DEBUG << "Received SSR delta " << delta.sequence_number << ".";
+
+    if (m_ssr_delta_decoder.apply(delta))
+    {
+        process_ssr_features(m_ssr_delta_decoder.objects(), m_ssr_delta_decoder.matrix());
+    }
+    else
+    {
+        ARMARX_WARNING << "Skipping SSR features until the next keyframe.";
+
+        // Do not stall the replay
+        if (getProperty<bool>("sync"))
+        {
+            m_received_ssr_feats = true;
+            m_proc_signal.notify_one();
+        }
+    }
+}
+
+
+void
+component::process_ssr_features(const std::vector<detected_object>& objects, const ssr::ssr_matrix& ssr_matrix)
+{
+    const std::size_t dim = ssr_matrix.dim();
+
+    ARMARX_DEBUG << "Received an " << dim << "x" << dim << " SSR features matrix.";
 
     for (unsigned int i = 0; i < dim; ++i) for (unsigned int j = 0; j < dim; ++j)
     {
         // Skip if i equals j (no self-relations).
         if (i == j) continue;
 
-        const relations& relations_ij = ssr_matrix.at(i).at(j);
-        for (const std::string& relation : relations_ij.string_list())
+        const relations& relations_ij = ssr_matrix(i, j);
+        for (const ssr::relation relation : relations_ij)
         {
-            std::string subject = objects[i].instance_name;
-            std::string object = objects[j].instance_name;
-            ARMARX_DEBUG << "Found relation `" << relation << "` "
-                         << "between `" << subject << "` and `" << object << "`.";
-
-            rels.emplace_back(i, j, relation);
+            ARMARX_DEBUG << "Found relation `" << ssr::name_of(relation) << "` "
+                         << "between `" << objects[i].instance_name << "` and `" << objects[j].instance_name << "`.";
         }
     }
 
     if (getProperty<bool>("write_to_disk"))
     {
         ARMARX_DEBUG << "Writing SSR features to disk.";
-        json ser = rels;
+        const json ser = ssr::relations_to_json(ssr_matrix);
         const std::string filename = "frame_" + std::to_string(m_current_frame_index) + ".json";
         const fs::path out = get_path(path_type::spatial_relations) / fs::path{filename};
         std::ofstream o{out.string()};
@@ -758,6 +737,17 @@ component::createPropertyDefinitions()
         "ssr_features",
         "Topic name where the SSR features are published."
     );
+    defs->defineOptionalProperty<std::string>(
+        "ssr_delta_topic",
+        "ssr_deltas",
+        "Topic name where the delta-encoded SSR features are published."
+    );
+    defs->defineOptionalProperty<bool>(
+        "use_ssr_delta_topic",
+        false,
+        "Whether to subscribe to the delta-encoded SSR features instead of the full ones (see the ssrfeatex property "
+        "ssr_delta_enabled)."
+    );
     defs->defineOptionalProperty<bool>(
         "write_to_disk",
         false,
@@ -37,6 +37,8 @@
 #include <VisionX/interface/components/YoloObjectListener.h>
 
 // corcal
+#include <corcal/core/ssr/delta_stream.h>
+#include <corcal/core/ssr/ssr_matrix.h>
 #include <corcal/interface/catalyst_component_interface.h>
 #include <corcal/interface/cnnreplay_component_interface.h>
 
@@ -78,6 +80,8 @@ protected:
     catalyst::component_interface::ProxyType m_catalyst;
     bool m_catalyst_initialised;
 
+    core::ssr::delta_decoder m_ssr_delta_decoder;
+
 public:
 
     component();
@@ -107,8 +111,22 @@ public:
         const Ice::Current&
     ) override;
 
+    virtual void ssr_delta_detected(
+        const corcal::core::ssr_delta& delta,
+        const Ice::Current&
+    ) override;
+
 private:
 
+    /**
+     * @brief Handles a full frame of SSR features, received directly or reconstructed from the delta topic.  Expects
+     *        m_proc_mutex to be locked
+     */
+    void process_ssr_features(
+        const std::vector<corcal::core::detected_object>& objects,
+        const core::ssr::ssr_matrix& ssr_matrix
+    );
+
     enum class path_type
     {
         depth,
@@ -25,7 +25,15 @@
 
 
 // STD/STL
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
+
+// Boost
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
 
 // ArmarX
 #include <ArmarXCore/core/exceptions/local/ExpressionException.h>
@@ -66,6 +74,39 @@ component::onInitComponent()
         offeringTopic(topic_name);
     }
 
+    // Topic name under which the packed detection results are published
+    if (getProperty<bool>("ssr_packed_features_enabled"))
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_packed_features_topic").getValue();
+        offeringTopic(topic_name);
+    }
+
+    // Topic name under which the sparse hand-centric detection results are published
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_sparse_features_topic").getValue();
+        offeringTopic(topic_name);
+    }
+
+    // Topic name under which the delta-encoded detection results are published
+    if (getProperty<bool>("ssr_delta_enabled"))
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_delta_topic").getValue();
+        offeringTopic(topic_name);
+    }
+
+    // Topic name under which the relation onsets and offsets are published
+    if (getProperty<bool>("ssr_events_enabled"))
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_events_topic").getValue();
+        offeringTopic(topic_name);
+    }
+
+    // Topic name under which the dynamic relations at each past horizon are published
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_horizon_features_topic").getValue();
+        offeringTopic(topic_name);
+    }
+
     ARMARX_DEBUG << "Initialised " << getName();
 }
 
@@ -81,6 +122,111 @@ component::onConnectComponent()
         m_ssr_feature_listener = getTopic<ssr_feature_listener::ProxyType>(topic_name);
     }
 
+    // Topic of packed SSR features
+    if (getProperty<bool>("ssr_packed_features_enabled"))
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_packed_features_topic");
+        m_ssr_packed_feature_listener = getTopic<ssr_packed_feature_listener::ProxyType>(topic_name);
+    }
+
+    // Topic of sparse hand-centric SSR features
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_sparse_features_topic");
+        m_ssr_sparse_feature_listener = getTopic<ssr_sparse_feature_listener::ProxyType>(topic_name);
+    }
+
+    // Topic of delta-encoded SSR features.  Start with a keyframe so that subscribers can synchronise
+    if (getProperty<bool>("ssr_delta_enabled"))
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_delta_topic");
+        m_ssr_delta_listener = getTopic<ssr_delta_listener::ProxyType>(topic_name);
+        m_ssr_delta_encoder.keyframe_interval(
+            static_cast<unsigned int>(getProperty<int>("ssr_delta_keyframe_interval").getValue()));
+        m_ssr_delta_encoder.request_keyframe();
+    }
+
+    // Topic of relation onsets and offsets.  Start from scratch, so that subscribers get onsets for all relations
+    if (getProperty<bool>("ssr_events_enabled"))
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_events_topic");
+        m_ssr_event_listener = getTopic<ssr_event_listener::ProxyType>(topic_name);
+        m_ssr_event_generator.reset();
+    }
+
+    // Topic of the dynamic relations at each past horizon
+    {
+        const std::string topic_name = getProperty<std::string>("ssr_horizon_features_topic");
+        m_ssr_horizon_feature_listener = getTopic<ssr_horizon_feature_listener::ProxyType>(topic_name);
+    }
+
+    // Start from scratch with each connection
+    if (getProperty<bool>("ssr.incremental"))
+    {
+        m_incremental_evaluator = std::make_unique<ssr::incremental_evaluator>(
+            getProperty<double>("ssr.distance_equality_threshold"),
+            getProperty<float>("ssr.incremental_epsilon")
+        );
+    }
+    else
+    {
+        m_incremental_evaluator.reset();
+    }
+
+    // Start with an empty cache with each connection
+    if (const int capacity = getProperty<int>("ssr.evaluation_cache_capacity"); capacity > 0)
+    {
+        m_evaluation_cache = std::make_unique<ssr::evaluation_cache>(
+            static_cast<std::size_t>(capacity),
+            getProperty<float>("ssr.evaluation_cache_resolution")
+        );
+    }
+    else
+    {
+        m_evaluation_cache.reset();
+    }
+
+    // Hand-centric mode, replacing the dense SSR matrix by the sparse cells of the pairs around the hands
+    if (getProperty<bool>("ssr.hand_centric"))
+    {
+        m_hand_centric_options = std::make_unique<ssr::hand_centric_options>();
+        m_hand_centric_options->hand_class_names.clear();
+        std::vector<std::string> split;
+        boost::algorithm::split(split, getProperty<std::string>("ssr.hand_centric_class_names").getValue(),
+                                boost::is_any_of(","));
+        for (const std::string& class_name : split)
+            m_hand_centric_options->hand_class_names.push_back(boost::algorithm::trim_copy(class_name));
+        m_hand_centric_options->neighbourhood_distance
+            = getProperty<float>("ssr.hand_centric_neighbourhood_distance");
+        m_hand_centric_options->nearest_neighbours
+            = static_cast<std::size_t>(getProperty<int>("ssr.hand_centric_nearest_neighbours").getValue());
+    }
+    else
+    {
+        m_hand_centric_options.reset();
+    }
+
+    const std::size_t temporal_filter_window
+        = static_cast<std::size_t>(getProperty<int>("ssr.temporal_filter_window").getValue());
+    switch (getProperty<temporal_filter_mode>("ssr.temporal_filter").getValue())
+    {
+        case temporal_filter_mode::none:
+            m_temporal_filter.reset();
+            break;
+        case temporal_filter_mode::majority:
+            m_temporal_filter = std::make_unique<ssr::temporal_filter>(
+                ssr::temporal_filter::majority(temporal_filter_window));
+            break;
+        case temporal_filter_mode::hysteresis:
+            m_temporal_filter = std::make_unique<ssr::temporal_filter>(
+                ssr::temporal_filter::hysteresis(temporal_filter_window));
+            break;
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock{m_relation_index_mutex};
+        m_relation_index.clear();
+    }
+
     // Kick off feature extraction task
     m_ssr_feature_extraction_task = new armarx::RunningTask<component>{
         this,
@@ -109,6 +255,12 @@ component::onDisconnectComponent()
         ARMARX_DEBUG << "Input synchronisation thread stopped";
     }
 
+    if (m_evaluation_cache)
+    {
+        ARMARX_VERBOSE << "SSR evaluation cache: " << m_evaluation_cache->hits() << " hits, "
+                       << m_evaluation_cache->misses() << " misses";
+    }
+
     ARMARX_DEBUG << "Disconnected " << getName();
 }
 
@@ -153,19 +305,112 @@ component::run_ssr_feature_extraction_task()
 
         // Do not use member variables prone to racing conditions from this point on
 
-        ARMARX_DEBUG << "Processing inputs and calculating SSRs";
         const double dist_eq_thresh = getProperty<double>("ssr.distance_equality_threshold");
-        const std::vector<std::vector<relations>> ssr_matrix = evaluate_relations(objects, dist_eq_thresh);
 
-        ARMARX_DEBUG << "Serialising SSR matrix";
-        const std::vector<std::vector<int>> ssr_matrix_serialised = serialise(ssr_matrix);
+        if (m_hand_centric_options)
+        {
+            ARMARX_DEBUG << "Calculating hand-centric SSRs";
+            const ssr_sparse_cell_list cells
+                = evaluate_relations_hand_centric(objects, dist_eq_thresh, *m_hand_centric_options);
+
+            ARMARX_DEBUG << "Publishing " << cells.size() << " sparse SSR cells";
+            m_ssr_sparse_feature_listener->ssr_features_detected_sparse(
+                objects,
+                cells,
+                timestamp.count()
+            );
+        }
+        else
+        {
+            ARMARX_DEBUG << "Processing inputs and calculating SSRs";
+            const evaluation_strategy strategy = getProperty<evaluation_strategy>("ssr.evaluation_strategy");
+            ssr::ssr_matrix ssr_matrix;
+            if (m_incremental_evaluator)
+            {
+                m_incremental_evaluator->distance_equality_threshold(dist_eq_thresh);
+                ssr_matrix = m_incremental_evaluator->evaluate(objects);
+                ARMARX_DEBUG << "Re-evaluated " << m_incremental_evaluator->dirty_count() << " of " << objects.size()
+                             << " objects";
+            }
+            else if (m_evaluation_cache)
+            {
+                ssr_matrix = m_evaluation_cache->evaluate(objects, dist_eq_thresh, strategy);
+                ARMARX_DEBUG << "SSR evaluation cache: " << m_evaluation_cache->hits() << " hits, "
+                             << m_evaluation_cache->misses() << " misses";
+            }
+            else
+            {
+                ssr_matrix = evaluate_relations(objects, dist_eq_thresh, strategy);
+            }
 
-        ARMARX_DEBUG << "Publishing SSR evaluation results";
-        m_ssr_feature_listener->ssr_features_detected(
-            objects,
-            ssr_matrix_serialised,
-            timestamp.count()
-        );
+            if (m_temporal_filter)
+            {
+                ssr_matrix = m_temporal_filter->filter(objects, ssr_matrix);
+                ARMARX_DEBUG << "Temporal filter suppressed " << m_temporal_filter->suppressed_count() << " relations";
+            }
+
+            if (getProperty<bool>("ssr.relation_index"))
+            {
+                ARMARX_DEBUG << "Updating relation index";
+                const std::lock_guard<std::mutex> lock{m_relation_index_mutex};
+                m_relation_index.update(objects, ssr_matrix);
+            }
+
+            ARMARX_DEBUG << "Serialising SSR matrix";
+            const std::vector<std::vector<int>> ssr_matrix_serialised = serialise(ssr_matrix);
+
+            ARMARX_DEBUG << "Publishing SSR evaluation results";
+            m_ssr_feature_listener->ssr_features_detected(
+                objects,
+                ssr_matrix_serialised,
+                timestamp.count()
+            );
+
+            if (getProperty<bool>("ssr_packed_features_enabled"))
+            {
+                ARMARX_DEBUG << "Publishing packed SSR evaluation results";
+                const bool run_length_encode = getProperty<bool>("ssr_packed_features_run_length_encoded");
+                m_ssr_packed_feature_listener->ssr_features_detected_packed(
+                    objects,
+                    pack(ssr_matrix, run_length_encode),
+                    timestamp.count()
+                );
+            }
+
+            if (getProperty<bool>("ssr_delta_enabled"))
+            {
+                ARMARX_DEBUG << "Publishing SSR delta";
+                m_ssr_delta_listener->ssr_delta_detected(
+                    m_ssr_delta_encoder.encode(objects, ssr_matrix, timestamp.count()));
+            }
+
+            if (getProperty<bool>("ssr_events_enabled"))
+            {
+                const std::vector<ssr_relation_event> events
+                    = m_ssr_event_generator.generate(objects, ssr_matrix, timestamp.count());
+                if (not events.empty())
+                {
+                    ARMARX_DEBUG << "Publishing " << events.size() << " relation onsets and offsets";
+                    m_ssr_event_listener->ssr_events_detected(events);
+                }
+            }
+
+            // Only if catalyst exports past bounding boxes at several horizons
+            if (not objects.empty() and not objects.front().past_bounding_boxes.empty())
+            {
+                ARMARX_DEBUG << "Evaluating and publishing dynamic relations at "
+                             << objects.front().past_bounding_boxes.size() << " horizons";
+                std::vector<core::ssr_matrix> dynamic_ssr_matrices_serialised;
+                for (const ssr::ssr_matrix& dynamic_ssr_matrix : evaluate_dynamic_relations_horizons(objects,
+                                                                                                     dist_eq_thresh))
+                    dynamic_ssr_matrices_serialised.push_back(serialise(dynamic_ssr_matrix));
+                m_ssr_horizon_feature_listener->ssr_horizon_features_detected(
+                    objects,
+                    dynamic_ssr_matrices_serialised,
+                    timestamp.count()
+                );
+            }
+        }
 
         const std::chrono::microseconds proc_duration = std::chrono::duration_cast<std::chrono::microseconds>(
             std::chrono::high_resolution_clock::now() - proc_start);
@@ -204,6 +449,56 @@ component::createPropertyDefinitions()
         "Output topic name under which the spatial symbolic relation features are published"
     );
 
+    // Packed result topic
+    defs->defineOptionalProperty<std::string>("ssr_packed_features_topic", "ssr_packed_features",
+        "Output topic name under which the spatial symbolic relation features are published packed, that is only "
+        "the upper triangle with 16 bit per cell"
+    );
+
+    defs->defineOptionalProperty<bool>("ssr_packed_features_enabled", false,
+        "Whether to publish on the packed topic"
+    );
+
+    defs->defineOptionalProperty<bool>("ssr_packed_features_run_length_encoded", true,
+        "Whether to run-length encode empty cells on the packed topic"
+    );
+
+    // Sparse result topic
+    defs->defineOptionalProperty<std::string>("ssr_sparse_features_topic", "ssr_sparse_features",
+        "Output topic name under which the non-empty cells of the pairs around the hands are published in coordinate "
+        "format, only if ssr.hand_centric is set"
+    );
+
+    // Delta-encoded result topic
+    defs->defineOptionalProperty<std::string>("ssr_delta_topic", "ssr_deltas",
+        "Output topic name under which only the changes of the spatial symbolic relation features are published"
+    );
+
+    defs->defineOptionalProperty<bool>("ssr_delta_enabled", false,
+        "Whether to delta-encode the SSR features and publish them on the delta topic"
+    );
+
+    defs->defineOptionalProperty<int>("ssr_delta_keyframe_interval",
+        static_cast<int>(default_keyframe_interval),
+        "Number of frames from one keyframe with the full state to the next on the delta topic"
+    ).setMin(1);
+
+    // Relation onset and offset topic
+    defs->defineOptionalProperty<std::string>("ssr_events_topic", "ssr_events",
+        "Output topic name under which the onsets and offsets of relations are published, only for frames where "
+        "relations changed"
+    );
+
+    defs->defineOptionalProperty<bool>("ssr_events_enabled", false,
+        "Whether to generate the onsets and offsets of relations and publish them on the events topic"
+    );
+
+    // Multi-horizon result topic
+    defs->defineOptionalProperty<std::string>("ssr_horizon_features_topic", "ssr_horizon_features",
+        "Output topic name under which the dynamic relations at each past horizon of the objects are published, if "
+        "the objects carry past bounding boxes at several horizons (see the catalyst property past_horizons)"
+    );
+
     // Input topic
     defs->defineOptionalProperty<std::string>("object_instances_topic", "ObjectInstances3D",
         "Input topic name under which the 3D object instances are published "
@@ -213,5 +508,76 @@ component::createPropertyDefinitions()
         "Distance in [mm] under which distance variations are considered noise and thus discarded"
     );
 
+    defs->defineOptionalProperty<evaluation_strategy>("ssr.evaluation_strategy", evaluation_strategy::fused,
+        "Strategy to evaluate the SSR matrix.  All yield identical results, three_pass is the slower reference "
+        "implementation kept for comparison, batched uses the SIMD kernel for contact and static relations, "
+        "small_scene uses the fixed-capacity evaluator for scenes of up to 64 objects, sweep uses the sweep-and-prune "
+        "broad phase for contact and static relations, which pays off for large scenes"
+    )
+    .map("fused", evaluation_strategy::fused)
+    .map("three_pass", evaluation_strategy::three_pass)
+    .map("batched", evaluation_strategy::batched)
+    .map("small_scene", evaluation_strategy::small_scene)
+    .map("sweep", evaluation_strategy::sweep);
+
+    defs->defineOptionalProperty<bool>("ssr.hand_centric", false,
+        "Only evaluate the pairs of each hand with every other object and the pairs of objects in the neighbourhood of "
+        "the hands, and publish them on the sparse topic only instead of all other topics"
+    );
+
+    defs->defineOptionalProperty<std::string>("ssr.hand_centric_class_names", "LeftHand,RightHand",
+        "Comma-separated class names of the objects which are hands in hand-centric mode"
+    );
+
+    defs->defineOptionalProperty<float>("ssr.hand_centric_neighbourhood_distance", 100,
+        "Distance in [mm] between bounding boxes up to which an object is in the neighbourhood of a hand in "
+        "hand-centric mode"
+    ).setMin(0);
+
+    defs->defineOptionalProperty<int>("ssr.hand_centric_nearest_neighbours", 2,
+        "Number of nearest objects which are in the neighbourhood of each hand in hand-centric mode, regardless of "
+        "their distance"
+    ).setMin(0);
+
+    defs->defineOptionalProperty<bool>("ssr.incremental", false,
+        "Only re-evaluate the relations of objects which appeared or moved since the previous frame, identified by "
+        "their instance name.  Overrides ssr.evaluation_strategy"
+    );
+
+    defs->defineOptionalProperty<float>("ssr.incremental_epsilon", 0,
+        "Distance in [mm] a bounding box coordinate may move before the relations of an object are re-evaluated in "
+        "incremental mode.  With 0, the results are identical to a full evaluation"
+    ).setMin(0);
+
+    defs->defineOptionalProperty<int>("ssr.evaluation_cache_capacity", 0,
+        "Number of SSR matrices of recurring scenes to keep in a least recently used cache, for example when "
+        "replaying recordings.  0 disables the cache.  Ignored in incremental mode"
+    ).setMin(0);
+
+    defs->defineOptionalProperty<float>("ssr.evaluation_cache_resolution", default_evaluation_cache_resolution,
+        "Resolution in [mm] to which bounding box coordinates are quantised to look up scenes in the evaluation "
+        "cache, so that scenes identical up to this resolution share one SSR matrix.  With 0, only bit-identical "
+        "scenes do"
+    ).setMin(0);
+
+    defs->defineOptionalProperty<temporal_filter_mode>("ssr.temporal_filter", temporal_filter_mode::none,
+        "Temporal filter to debounce flickering relations over the last ssr.temporal_filter_window frames.  With "
+        "majority, a relation is active if it was active in most of these frames.  With hysteresis, a relation only "
+        "changes its state after keeping the new state in all of these frames"
+    )
+    .map("none", temporal_filter_mode::none)
+    .map("majority", temporal_filter_mode::majority)
+    .map("hysteresis", temporal_filter_mode::hysteresis);
+
+    defs->defineOptionalProperty<int>("ssr.temporal_filter_window",
+        static_cast<int>(default_temporal_filter_window),
+        "Number of frames the temporal filter looks back"
+    ).setMin(1).setMax(static_cast<int>(max_temporal_filter_window));
+
+    defs->defineOptionalProperty<bool>("ssr.relation_index", false,
+        "Maintain an inverted index of the relations of the most recent frame, which answers per-relation and "
+        "per-instance queries without scanning the SSR matrix"
+    );
+
     return defs;
 }
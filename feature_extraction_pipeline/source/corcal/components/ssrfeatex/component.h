@@ -27,6 +27,7 @@
 // STD/STL
 #include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
 
@@ -66,6 +67,41 @@ class component :
          */
         ssr_feature_listener::ProxyType m_ssr_feature_listener;
 
+        /**
+         * @brief Listener proxy to publish the packed SSR features
+         */
+        ssr_packed_feature_listener::ProxyType m_ssr_packed_feature_listener;
+
+        /**
+         * @brief Listener proxy to publish the sparse hand-centric SSR features
+         */
+        ssr_sparse_feature_listener::ProxyType m_ssr_sparse_feature_listener;
+
+        /**
+         * @brief Listener proxy to publish the delta-encoded SSR features
+         */
+        ssr_delta_listener::ProxyType m_ssr_delta_listener;
+
+        /**
+         * @brief Listener proxy to publish the dynamic relations at each past horizon of the objects
+         */
+        ssr_horizon_feature_listener::ProxyType m_ssr_horizon_feature_listener;
+
+        /**
+         * @brief Listener proxy to publish onsets and offsets of relations
+         */
+        ssr_event_listener::ProxyType m_ssr_event_listener;
+
+        /**
+         * @brief Generator of the relation onsets and offsets, only used by the worker task
+         */
+        core::ssr::event_generator m_ssr_event_generator;
+
+        /**
+         * @brief Encoder of the SSR delta stream, only used by the worker task
+         */
+        core::ssr::delta_encoder m_ssr_delta_encoder;
+
         /**
          * @brief Processing mutex used together with m_proc_signal
          */
@@ -86,6 +122,38 @@ class component :
          */
         armarx::RunningTask<component>::pointer_type m_ssr_feature_extraction_task;
 
+        /**
+         * @brief Evaluator reusing the relations of unchanged objects across frames, only used by the worker task and
+         *        only if the property ssr.incremental is set
+         */
+        std::unique_ptr<core::ssr::incremental_evaluator> m_incremental_evaluator;
+
+        /**
+         * @brief Memo cache of the SSR matrices of recurring scenes, only used by the worker task and only if the
+         *        property ssr.evaluation_cache_capacity is not 0
+         */
+        std::unique_ptr<core::ssr::evaluation_cache> m_evaluation_cache;
+
+        /**
+         * @brief Pairs to evaluate in hand-centric mode, only used by the worker task and only if the property
+         *        ssr.hand_centric is set
+         */
+        std::unique_ptr<core::ssr::hand_centric_options> m_hand_centric_options;
+
+        /**
+         * @brief Filter debouncing flickering relations, only used by the worker task and only if the property
+         *        ssr.temporal_filter is set
+         */
+        std::unique_ptr<core::ssr::temporal_filter> m_temporal_filter;
+
+        /**
+         * @brief Inverted index of the relations of the most recent frame, only maintained if the property
+         *        ssr.relation_index is set.  Shared with query methods, hence guarded by m_relation_index_mutex
+         */
+        core::ssr::relation_index m_relation_index;
+
+        mutable std::mutex m_relation_index_mutex;
+
         std::vector<core::detected_object> m_detected_object_buffer;
         std::chrono::microseconds m_timestamp_detected_objects;
 
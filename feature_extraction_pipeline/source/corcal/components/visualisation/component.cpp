@@ -92,9 +92,11 @@ component::onInitImageProcessor()
         usingTopic(topic_name);
     }
 
-    // Signal dependency on the topic where the SSR features are published
+    // Signal dependency on the topic where the SSR features are published, either in full or delta-encoded
     {
-        const std::string topic_name = getProperty<std::string>("ssr_features_topic");
+        const std::string topic_name = getProperty<bool>("use_ssr_delta_topic")
+            ? getProperty<std::string>("ssr_delta_topic").getValue()
+            : getProperty<std::string>("ssr_features_topic").getValue();
         usingTopic(topic_name);
     }
 
@@ -268,6 +270,13 @@ component::createPropertyDefinitions()
     defs->defineOptionalProperty<std::string>("ssr_features_topic", "ssr_features",
         "Topic name where the SSR features are published"
     );
+    defs->defineOptionalProperty<std::string>("ssr_delta_topic", "ssr_deltas",
+        "Topic name where the delta-encoded SSR features are published"
+    );
+    defs->defineOptionalProperty<bool>("use_ssr_delta_topic", false,
+        "Subscribe to the delta-encoded SSR features instead of the full ones (see the ssrfeatex property "
+        "ssr_delta_enabled)"
+    );
     defs->defineOptionalProperty<bool>("dull_rgb", false, "Make RGB in debug pointcloud more dull");
     defs->defineOptionalProperty<int>("rgb_image_buffer_size", 60,
         "Size [in frames] of the long term image buffer that are buffered in total"
@@ -434,8 +443,22 @@ component::ssr_features_detected(
         Ice::Long /*timestamp*/,
         const Ice::Current&)
 {
-    const std::vector<std::vector<relations>> ssr_matrix = unserialise(ssr_matrix_serialised);
-    const unsigned long dim = ssr_matrix.size();
+    draw_relations(objects, unserialise(ssr_matrix_serialised));
+}
+
+
+void
+component::ssr_delta_detected(const ssr_delta& delta, const Ice::Current&)
+{
+    if (m_ssr_delta_decoder.apply(delta))
+        draw_relations(m_ssr_delta_decoder.objects(), m_ssr_delta_decoder.matrix());
+}
+
+
+void
+component::draw_relations(const std::vector<detected_object>& objects, const ssr::ssr_matrix& ssr_matrix)
+{
+    const std::size_t dim = ssr_matrix.dim();
 
     ARMARX_DEBUG << "Received an " << dim << "x" << dim << " SSR features matrix";
 
@@ -457,9 +480,9 @@ component::ssr_features_detected(
         // Skip if i equals j (no self-relations)
         if (i == j) continue;
 
-        const relations& relations_ij = ssr_matrix.at(i).at(j);
+        const relations& relations_ij = ssr_matrix(i, j);
 
-        for (const std::string& rel : relations_ij.string_list())
+        for (const relation rel : relations_ij)
         {
             armarx::DrawColor colour{0, 0, 0, 1};
             enum class mode
@@ -476,17 +499,17 @@ component::ssr_features_detected(
             const mode m = mode::static_xyz;
             if (m == mode::static_xyz)
             {
-                if (rel == "left of" or rel == "right of")
+                if (rel == relation::static_left_of or rel == relation::static_right_of)
                 {
                     colour.r = 1;
 
                 }
-                else if (rel == "above" or rel == "below")
+                else if (rel == relation::static_above or rel == relation::static_below)
                 {
                     colour.g = 1;
                     xo = yo = zo = 5;
                 }
-                else if (rel == "in front of" or rel == "behind of")
+                else if (rel == relation::static_in_front_of or rel == relation::static_behind_of)
                 {
                     colour.b = 1;
                     xo = yo = zo = 10;
@@ -498,15 +521,15 @@ component::ssr_features_detected(
             }
             else if (m == mode::dynamic_no_contact)
             {
-                if (rel == "getting close")
+                if (rel == relation::dynamic_getting_close)
                 {
                     colour.r = 1;
                 }
-                else if (rel == "stable")
+                else if (rel == relation::dynamic_stable)
                 {
                     continue;
                 }
-                else if (rel == "moving apart")
+                else if (rel == relation::dynamic_moving_apart)
                 {
                     colour.g = 1;
                 }
@@ -517,11 +540,11 @@ component::ssr_features_detected(
             }
             else if (m == mode::dynamic_contact)
             {
-                if (rel == "moving together")
+                if (rel == relation::dynamic_moving_together)
                 {
                     colour.r = 1;
                 }
-                else if (rel == "fixed moving together")
+                else if (rel == relation::dynamic_fixed_moving_together)
                 {
                     colour.b = 1;
                 }
@@ -535,7 +558,8 @@ component::ssr_features_detected(
                 continue;
             }
 
-            std::string arrow_name = "rel_" + objects[i].instance_name + "_" + objects[j].instance_name + "_" + rel;
+            std::string arrow_name = "rel_" + objects[i].instance_name + "_" + objects[j].instance_name + "_"
+                + std::string{name_of(rel)};
             const armarx::Vector3BasePtr origin{new armarx::Vector3{
                 xo + (objects[i].bounding_box.x0 + objects[i].bounding_box.x1) / 2,
                 yo + (objects[i].bounding_box.y0 + objects[i].bounding_box.y1) / 2,
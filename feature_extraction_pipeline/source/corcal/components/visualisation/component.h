@@ -35,6 +35,8 @@
 #include <VisionX/core/ImageProcessor.h>
 
 // corcal
+#include <corcal/core/ssr/delta_stream.h>
+#include <corcal/core/ssr/ssr_matrix.h>
 #include <corcal/interface/data_structures.h>
 #include <corcal/interface/visualisation_component_interface.h>
 
@@ -71,6 +73,9 @@ class component :
         unsigned int m_draw_layer;
         unsigned int m_draw_layer2;
 
+        // Reconstructs the SSR features if subscribed to the delta topic
+        core::ssr::delta_decoder m_ssr_delta_decoder;
+
     public:
 
         virtual ~component() override;
@@ -100,6 +105,11 @@ class component :
             const Ice::Current&
         ) override;
 
+        virtual void ssr_delta_detected(
+            const corcal::core::ssr_delta& delta,
+            const Ice::Current&
+        ) override;
+
     protected:
 
         void
@@ -120,6 +130,14 @@ class component :
         armarx::PropertyDefinitionsPtr
         virtual createPropertyDefinitions() override;
 
+    private:
+
+        void
+        draw_relations(
+            const std::vector<corcal::core::detected_object>& objects,
+            const core::ssr::ssr_matrix& ssr_matrix
+        );
+
 };
 
 
@@ -0,0 +1,498 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::benchmark
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+// STD/STL
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// JSON
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+// corcal
+#include <corcal/core/ssr.h>
+#include <corcal/core/vwm.h>
+
+
+using namespace corcal::core;
+namespace ch = std::chrono;
+
+
+/**
+ * Allocation counting.  Every allocation of the process goes through these replacements, so that the number of
+ * allocations per operation can be reported next to its duration
+ */
+namespace
+{
+    std::atomic<std::size_t> allocation_count{0};
+
+
+    void*
+    counted_allocation(std::size_t size)
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        if (void* pointer = std::malloc(size == 0 ? 1 : size))
+            return pointer;
+        throw std::bad_alloc{};
+    }
+
+
+    void*
+    counted_aligned_allocation(std::size_t size, std::align_val_t alignment)
+    {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        const std::size_t align = static_cast<std::size_t>(alignment);
+        // std::aligned_alloc requires the size to be a multiple of the alignment
+        const std::size_t padded_size = ((size == 0 ? 1 : size) + align - 1) / align * align;
+        if (void* pointer = std::aligned_alloc(align, padded_size))
+            return pointer;
+        throw std::bad_alloc{};
+    }
+}
+
+
+void* operator new(std::size_t size) { return ::counted_allocation(size); }
+void* operator new[](std::size_t size) { return ::counted_allocation(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return ::counted_aligned_allocation(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return ::counted_aligned_allocation(size, alignment); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+
+namespace
+{
+    /**
+     * @brief Parameters of the synthetic scenes
+     */
+    struct scene_parameters
+    {
+        /**
+         * @brief Average edge length of a bounding box relative to the average spacing of the objects.  Around 0 there
+         *        are hardly any contacts, from 1 on most neighbours touch
+         */
+        double overlap = 0.5;
+
+        /**
+         * @brief Maximum displacement in [mm] of a moving object between its past and its current bounding box
+         */
+        double motion = 60;
+
+        /**
+         * @brief Share of the objects which moved
+         */
+        double moving = 0.5;
+    };
+
+
+    /**
+     * @brief Average distance in [mm] of neighbouring objects in a synthetic scene
+     */
+    const float spacing = 200;
+
+
+    std::vector<detected_object>
+    make_scene(std::mt19937& rng, std::size_t dim, const scene_parameters& parameters)
+    {
+        const float extent = spacing * static_cast<float>(std::cbrt(static_cast<double>(dim)));
+        const float mean_size = std::max(1.f, static_cast<float>(parameters.overlap) * spacing);
+
+        std::uniform_real_distribution<float> position{0, extent};
+        std::uniform_real_distribution<float> size{mean_size / 2, mean_size * 3 / 2};
+        std::uniform_real_distribution<float> displacement{-static_cast<float>(parameters.motion),
+                                                           static_cast<float>(parameters.motion)};
+        std::bernoulli_distribution moved{parameters.moving};
+
+        std::vector<detected_object> objects(dim);
+        for (std::size_t index = 0; index < dim; ++index)
+        {
+            detected_object& object = objects[index];
+            object.class_name = "class_" + std::to_string(index % 16);
+            object.class_index = static_cast<int>(index % 16);
+            object.instance_name = object.class_name + "_" + std::to_string(index);
+            object.certainty = 1;
+
+            visionx::BoundingBox3D& bb = object.bounding_box;
+            bb.x0 = position(rng);
+            bb.y0 = position(rng);
+            bb.z0 = position(rng);
+            bb.x1 = bb.x0 + size(rng);
+            bb.y1 = bb.y0 + size(rng);
+            bb.z1 = bb.z0 + size(rng);
+
+            object.past_bounding_box = bb;
+            if (moved(rng))
+            {
+                const float dx = displacement(rng);
+                const float dy = displacement(rng);
+                const float dz = displacement(rng);
+                object.past_bounding_box.x0 += dx;
+                object.past_bounding_box.x1 += dx;
+                object.past_bounding_box.y0 += dy;
+                object.past_bounding_box.y1 += dy;
+                object.past_bounding_box.z0 += dz;
+                object.past_bounding_box.z1 += dz;
+            }
+        }
+
+        return objects;
+    }
+
+
+    /**
+     * @brief Observation of the given object as the 2D object detection would report it, that is with the centre of
+     *        its bounding box in normalised image coordinates
+     */
+    observation::ptr
+    make_observation(const detected_object& object, float extent, ch::microseconds seen_at)
+    {
+        candidate c;
+        c.class_name(object.class_name);
+        c.class_index(object.class_index);
+        c.certainty(object.certainty);
+
+        const visionx::BoundingBox3D& bb = object.bounding_box;
+        observation::ptr o = observation::create();
+        o->candidates({c});
+        o->class_count(1);
+        o->seen_at(seen_at);
+        o->xmin(bb.x0 / extent);
+        o->xmax(bb.x1 / extent);
+        o->ymin(bb.y0 / extent);
+        o->ymax(bb.y1 / extent);
+        o->cx((bb.x0 + bb.x1) / 2 / extent);
+        o->cy((bb.y0 + bb.y1) / 2 / extent);
+        o->w((bb.x1 - bb.x0) / extent);
+        o->h((bb.y1 - bb.y0) / extent);
+        o->bounding_box(bb);
+        return o;
+    }
+
+
+    /**
+     * @brief Keeps the compiler from optimising away a computation whose result is otherwise unused
+     */
+    template <typename T>
+    void
+    do_not_optimise(const T& value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+
+    struct measurement
+    {
+        std::size_t iterations;
+        double ns_per_op;
+        double allocs_per_op;
+    };
+
+
+    /**
+     * @brief Runs run(i) for i in [0, iterations), doubling iterations until the loop takes at least min_duration or
+     *        max_iterations is reached.  setup(iterations) is called before each attempt and is not measured, so it
+     *        must reset any state run changes
+     */
+    measurement
+    measure(
+        const ch::nanoseconds min_duration,
+        const std::size_t max_iterations,
+        const std::function<void(std::size_t)>& setup,
+        const std::function<void(std::size_t)>& run)
+    {
+        // Warm-up, for example to let the allocator consolidate memory freed by a previous benchmark
+        setup(1);
+        run(0);
+
+        std::size_t iterations = 1;
+        while (true)
+        {
+            setup(iterations);
+
+            const std::size_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+            const auto start = ch::steady_clock::now();
+            for (std::size_t i = 0; i < iterations; ++i)
+                run(i);
+            const ch::nanoseconds elapsed = ch::steady_clock::now() - start;
+            const std::size_t allocations = allocation_count.load(std::memory_order_relaxed) - allocations_before;
+
+            if (elapsed >= min_duration or iterations >= max_iterations)
+            {
+                return measurement{
+                    iterations,
+                    static_cast<double>(elapsed.count()) / static_cast<double>(iterations),
+                    static_cast<double>(allocations) / static_cast<double>(iterations)
+                };
+            }
+
+            iterations = std::min(iterations * 2, max_iterations);
+        }
+    }
+
+
+    void
+    print_usage(const char* name)
+    {
+        std::cerr << "Usage: " << name << " [--min-objects N] [--max-objects N] [--overlap F] [--motion MM] "
+                  << "[--moving F] [--threshold MM] [--min-time MS] [--seed N]" << std::endl;
+    }
+}
+
+
+/**
+ * Microbenchmark of core::ssr and core::vwm on synthetic scenes.  Scene sizes go from --min-objects to --max-objects
+ * in powers of two.  One operation is always the processing of one whole scene.  Prints JSON to stdout
+ */
+int
+main(int argc, char* argv[])
+{
+    std::map<std::string, double> options{
+        {"--min-objects", 2},
+        {"--max-objects", 1024},
+        {"--overlap", scene_parameters{}.overlap},
+        {"--motion", scene_parameters{}.motion},
+        {"--moving", scene_parameters{}.moving},
+        {"--threshold", 30},
+        {"--min-time", 200},
+        {"--seed", 42}
+    };
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (options.count(argv[arg]) == 0 or arg + 1 == argc)
+        {
+            ::print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        options[argv[arg]] = std::stod(argv[arg + 1]);
+        ++arg;
+    }
+
+    ::scene_parameters parameters;
+    parameters.overlap = options["--overlap"];
+    parameters.motion = options["--motion"];
+    parameters.moving = options["--moving"];
+    const double threshold = options["--threshold"];
+    const std::size_t min_objects = std::max<std::size_t>(1, static_cast<std::size_t>(options["--min-objects"]));
+    const std::size_t max_objects = static_cast<std::size_t>(options["--max-objects"]);
+    const ch::nanoseconds min_duration = ch::milliseconds{static_cast<long>(options["--min-time"])};
+    std::mt19937 rng{static_cast<std::mt19937::result_type>(options["--seed"])};
+
+    json results = json::array();
+    const auto record = [&](const std::string& benchmark, std::size_t dim, const ::measurement& m)
+    {
+        results.push_back(json
+        {
+            {"benchmark", benchmark},
+            {"objects", dim},
+            {"iterations", m.iterations},
+            {"ns_per_op", m.ns_per_op},
+            {"allocs_per_op", m.allocs_per_op}
+        });
+    };
+
+    const auto no_setup = [](std::size_t) {};
+    const std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+    for (std::size_t dim = min_objects; dim <= max_objects; dim *= 2)
+    {
+        const std::vector<detected_object> objects = ::make_scene(rng, dim, parameters);
+        ssr::ssr_matrix scratch{dim};
+
+        // Raw buffers for the kernel, as offline tools would hand them over
+        std::vector<float> interleaved;
+        std::vector<float> past_interleaved;
+        for (const detected_object& object : objects)
+        {
+            const visionx::BoundingBox3D& bb = object.bounding_box;
+            const visionx::BoundingBox3D& past_bb = object.past_bounding_box;
+            interleaved.insert(interleaved.end(), {bb.x0, bb.y0, bb.z0, bb.x1, bb.y1, bb.z1});
+            past_interleaved.insert(past_interleaved.end(), {past_bb.x0, past_bb.y0, past_bb.z0, past_bb.x1,
+                                                             past_bb.y1, past_bb.z1});
+        }
+        std::vector<std::uint16_t> masks(dim * dim, 0);
+
+        // Relation evaluation
+        record("evaluate_relations", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            ::do_not_optimise(evaluate_relations(objects, threshold));
+        }));
+        record("evaluate_relations_three_pass", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            ::do_not_optimise(evaluate_relations_three_pass(objects, threshold));
+        }));
+        record("kernel_interleaved", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            ssr::kernel::evaluate_relations(ssr::kernel::interleaved_boxes<float>{interleaved.data(), dim},
+                                            ssr::kernel::interleaved_boxes<float>{past_interleaved.data(), dim},
+                                            threshold, masks.data());
+            ::do_not_optimise(masks);
+        }));
+        record("evaluate_contact_relations", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            evaluate_contact_relations(objects, scratch);
+            ::do_not_optimise(scratch);
+        }));
+        record("evaluate_static_relations", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            evaluate_static_relations(objects, scratch);
+            ::do_not_optimise(scratch);
+        }));
+        record("evaluate_static_relations_batched", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            evaluate_static_relations_batched(objects, scratch);
+            ::do_not_optimise(scratch);
+        }));
+        record("evaluate_static_relations_sweep", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            evaluate_static_relations_sweep(objects, scratch);
+            ::do_not_optimise(scratch);
+        }));
+        record("evaluate_dynamic_relations", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            evaluate_dynamic_relations(objects, scratch, threshold);
+            ::do_not_optimise(scratch);
+        }));
+
+        // Serialisation
+        const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, threshold);
+        const std::vector<std::vector<int>> serialised = serialise(ssr_matrix);
+        record("serialise", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            ::do_not_optimise(serialise(ssr_matrix));
+        }));
+        record("unserialise", dim, ::measure(min_duration, unlimited, no_setup, [&](std::size_t)
+        {
+            ::do_not_optimise(unserialise(serialised));
+        }));
+
+        // Visual working memory: one frame of observations of all objects per operation, 30 fps, objects drifting
+        // between frames
+        const float extent = spacing * static_cast<float>(std::cbrt(static_cast<double>(dim))) * 2;
+        const ch::microseconds frame_duration{33333};
+        vwm::memory memory{0, ch::milliseconds{750}};
+        std::vector<std::vector<observation::ptr>> frames;
+        const auto setup_frames = [&](std::size_t iterations)
+        {
+            memory.reset();
+            frames.assign(iterations, {});
+            std::vector<detected_object> drifting = objects;
+            std::uniform_real_distribution<float> drift{-2, 2};
+            for (std::size_t frame = 0; frame < iterations; ++frame)
+            {
+                for (detected_object& object : drifting)
+                {
+                    const float dx = drift(rng);
+                    object.bounding_box.x0 += dx;
+                    object.bounding_box.x1 += dx;
+                    frames[frame].push_back(::make_observation(object, extent, frame_duration * (frame + 1)));
+                }
+            }
+        };
+        // Bound the number of pre-generated observations
+        const std::size_t max_frames = std::max<std::size_t>(1, (std::size_t{1} << 20) / dim);
+        record("memory::make_observations", dim, ::measure(min_duration, max_frames, setup_frames, [&](std::size_t i)
+        {
+            memory.now(frame_duration * (i + 1));
+            memory.make_observations(frames[i]);
+        }));
+        // The same with a gating distance, so that known objects are looked up in the spatial grid
+        memory.match_gating_distance(0.05);
+        record("memory::make_observations (gated)", dim, ::measure(min_duration, max_frames, setup_frames,
+                                                                   [&](std::size_t i)
+        {
+            memory.now(frame_duration * (i + 1));
+            memory.make_observations(frames[i]);
+        }));
+        frames.clear();
+
+        // Smoothing: each object remembers one second of observations, averaged over the last 500 ms
+        std::vector<known_object::ptr> known_objects;
+        const ch::microseconds now = frame_duration * 30;
+        for (std::size_t index = 0; index < dim; ++index)
+        {
+            known_object::ptr known = std::make_shared<known_object>(
+                ::make_observation(objects[index], extent, frame_duration), static_cast<unsigned int>(index));
+            for (unsigned int frame = 2; frame <= 30; ++frame)
+                known->remember_observation(::make_observation(objects[index], extent, frame_duration * frame));
+            known_objects.push_back(known);
+        }
+        const bounding_box_smoother gaussian{ch::milliseconds{500}, smoothing_kernel::gaussian};
+        record("known_object::average_bounding_boxes (gaussian)", dim, ::measure(min_duration, unlimited, no_setup,
+                                                                                 [&](std::size_t)
+        {
+            for (std::size_t index = 0; index < dim; ++index)
+            {
+                ::do_not_optimise(known_objects[index]->average_bounding_boxes(objects[index].bounding_box, now,
+                                                                                gaussian));
+            }
+        }));
+        const bounding_box_smoother exponential{ch::milliseconds{500}, smoothing_kernel::exponential};
+        record("known_object::average_bounding_boxes (exponential)", dim, ::measure(min_duration, unlimited, no_setup,
+                                                                                    [&](std::size_t)
+        {
+            for (std::size_t index = 0; index < dim; ++index)
+            {
+                ::do_not_optimise(known_objects[index]->average_bounding_boxes(objects[index].bounding_box, now,
+                                                                                exponential));
+            }
+        }));
+    }
+
+    const json report
+    {
+        {"config", {
+            {"overlap", parameters.overlap},
+            {"motion", parameters.motion},
+            {"moving", parameters.moving},
+            {"threshold", threshold},
+            {"min_time_ms", options["--min-time"]},
+            {"seed", options["--seed"]},
+            {"instruction_set", to_string(detect_instruction_set())}
+        }},
+        {"results", results}
+    };
+    std::cout << std::setw(4) << report << std::endl;
+
+    return EXIT_SUCCESS;
+}
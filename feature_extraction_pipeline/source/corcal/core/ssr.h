@@ -30,8 +30,18 @@
 #include <vector>
 
 // corcal
+#include <corcal/core/ssr/delta_stream.h>
+#include <corcal/core/ssr/evaluation_cache.h>
+#include <corcal/core/ssr/event_generator.h>
 #include <corcal/core/ssr/functions.h>
+#include <corcal/core/ssr/incremental_evaluator.h>
+#include <corcal/core/ssr/kernel.h>
+#include <corcal/core/ssr/object_series.h>
+#include <corcal/core/ssr/relation_index.h>
 #include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/small_scene.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/core/ssr/temporal_filter.h>
 #include <corcal/interface/data_structures.h>
 
 
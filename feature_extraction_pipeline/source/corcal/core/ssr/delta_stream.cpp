@@ -0,0 +1,343 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#include <corcal/core/ssr/delta_stream.h>
+
+
+// STD/STL
+#include <utility>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+#include <ArmarXCore/core/logging/Logging.h>
+
+// corcal
+#include <corcal/core/ssr/functions.h>
+
+
+using namespace corcal::core;
+using namespace corcal::core::ssr;
+
+
+namespace
+{
+    const std::size_t no_index = corcal::core::ssr::no_previous_index;
+
+
+    /**
+     * @brief Whether the objects only differ in their bounding boxes
+     */
+    bool
+    only_moved(const detected_object& object, const detected_object& previous)
+    {
+        return object.class_name == previous.class_name
+            and object.class_index == previous.class_index
+            and object.instance_name == previous.instance_name
+            and object.certainty == previous.certainty
+            and object.colour == previous.colour;
+    }
+}
+
+
+delta_encoder::delta_encoder(unsigned int keyframe_interval) :
+    m_keyframe_interval{keyframe_interval},
+    m_frames_since_keyframe{0},
+    m_sequence_number{0},
+    m_next_id{0}
+{
+    ARMARX_CHECK_GREATER(keyframe_interval, 0);
+}
+
+
+ssr_delta
+delta_encoder::encode(
+    const std::vector<detected_object>& objects,
+    const ssr::ssr_matrix& ssr_matrix,
+    std::int64_t timestamp)
+{
+    ARMARX_CHECK_EQUAL_W_HINT(objects.size(), ssr_matrix.dim(), "SSR matrix does not match the objects");
+
+    const std::size_t dim = objects.size();
+    const std::vector<std::string> keys = ssr::instance_keys(objects);
+
+    ssr_delta delta;
+    delta.sequence_number = m_sequence_number++;
+    delta.keyframe = m_frames_since_keyframe == 0;
+    delta.timestamp = timestamp;
+    m_frames_since_keyframe = (m_frames_since_keyframe + 1) % m_keyframe_interval;
+
+    // Find each object in the previous frame, or assign a new id
+    const std::vector<std::size_t> previous
+        = ssr::match_previous_frame(keys, m_keys, m_previous_index).previous;
+
+    std::vector<int> ids(dim);
+    for (std::size_t i = 0; i < dim; ++i)
+        ids[i] = previous[i] != ::no_index ? m_ids[previous[i]] : m_next_id++;
+    delta.object_order = ids;
+
+    if (delta.keyframe)
+    {
+        for (std::size_t i = 0; i < dim; ++i)
+            delta.changed_objects.push_back(ssr_object_delta{ids[i], objects[i]});
+
+        for (std::size_t i = 0; i < dim; ++i) for (std::size_t j = 0; j < dim; ++j)
+        {
+            const int mask = ssr_matrix(i, j).mask();
+            if (mask != 0)
+                delta.changed_cells.push_back(ssr_cell_delta{ids[i], ids[j], 0, mask});
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < dim; ++i)
+        {
+            if (previous[i] == ::no_index)
+            {
+                delta.changed_objects.push_back(ssr_object_delta{ids[i], objects[i]});
+            }
+            else if (objects[i] != m_objects[previous[i]])
+            {
+                if (::only_moved(objects[i], m_objects[previous[i]]))
+                {
+                    delta.moved_objects.push_back(ssr_object_motion{
+                        ids[i], objects[i].bounding_box, objects[i].past_bounding_box, objects[i].past_bounding_boxes});
+                }
+                else
+                {
+                    delta.changed_objects.push_back(ssr_object_delta{ids[i], objects[i]});
+                }
+            }
+        }
+
+        // Cells of new objects changed from "no relation", cells of removed objects are dropped implicitly
+        for (std::size_t i = 0; i < dim; ++i) for (std::size_t j = 0; j < dim; ++j)
+        {
+            if (i == j) continue;
+
+            const int new_mask = ssr_matrix(i, j).mask();
+            const int old_mask = previous[i] != ::no_index and previous[j] != ::no_index
+                ? m_ssr_matrix(previous[i], previous[j]).mask() : 0;
+
+            if (new_mask != old_mask)
+                delta.changed_cells.push_back(ssr_cell_delta{ids[i], ids[j], old_mask, new_mask});
+        }
+    }
+
+    m_keys = keys;
+    m_ids = std::move(ids);
+    m_objects = objects;
+    m_ssr_matrix = ssr_matrix;
+
+    return delta;
+}
+
+
+void
+delta_encoder::request_keyframe()
+{
+    m_frames_since_keyframe = 0;
+}
+
+
+unsigned int
+delta_encoder::keyframe_interval() const
+{
+    return m_keyframe_interval;
+}
+
+
+void
+delta_encoder::keyframe_interval(unsigned int keyframe_interval)
+{
+    ARMARX_CHECK_GREATER(keyframe_interval, 0);
+    m_keyframe_interval = keyframe_interval;
+    m_frames_since_keyframe %= keyframe_interval;
+}
+
+
+delta_decoder::delta_decoder() :
+    m_synchronised{false},
+    m_sequence_number{0},
+    m_timestamp{0}
+{
+    // pass
+}
+
+
+bool
+delta_decoder::apply(const ssr_delta& delta)
+{
+    if (delta.keyframe)
+    {
+        m_objects.clear();
+        m_ids.clear();
+        m_index_of.clear();
+        m_ssr_matrix.reset(0);
+        m_synchronised = true;
+    }
+    else if (not m_synchronised or delta.sequence_number != m_sequence_number + 1)
+    {
+        m_synchronised = false;
+        return false;
+    }
+
+    m_sequence_number = delta.sequence_number;
+    m_timestamp = delta.timestamp;
+
+    // Only re-layout the matrix if objects appeared, disappeared or were reordered
+    if (delta.object_order != m_ids and not relayout(delta))
+    {
+        ARMARX_WARNING << "SSR delta " << delta.sequence_number << " refers to unknown objects, "
+                       << "waiting for the next keyframe";
+        m_synchronised = false;
+        return false;
+    }
+
+    for (const ssr_object_delta& object_delta : delta.changed_objects)
+    {
+        const auto it = m_index_of.find(object_delta.id);
+        if (it != m_index_of.end())
+            m_objects[it->second] = object_delta.instance;
+    }
+
+    for (const ssr_object_motion& motion : delta.moved_objects)
+    {
+        const auto it = m_index_of.find(motion.id);
+        if (it == m_index_of.end())
+        {
+            ARMARX_WARNING << "SSR delta " << delta.sequence_number << " moves an unknown object, "
+                           << "waiting for the next keyframe";
+            m_synchronised = false;
+            return false;
+        }
+
+        detected_object& object = m_objects[it->second];
+        object.bounding_box = motion.bounding_box;
+        object.past_bounding_box = motion.past_bounding_box;
+        object.past_bounding_boxes = motion.past_bounding_boxes;
+    }
+
+    for (const ssr_cell_delta& cell_delta : delta.changed_cells)
+    {
+        const auto subject = m_index_of.find(cell_delta.subject_id);
+        const auto object = m_index_of.find(cell_delta.object_id);
+
+        if (subject == m_index_of.end() or object == m_index_of.end()
+            or m_ssr_matrix(subject->second, object->second).mask() != cell_delta.old_mask)
+        {
+            ARMARX_WARNING << "SSR delta " << delta.sequence_number << " does not match the reconstructed state, "
+                           << "waiting for the next keyframe";
+            m_synchronised = false;
+            return false;
+        }
+
+        m_ssr_matrix(subject->second, object->second) = relations{cell_delta.new_mask};
+    }
+
+    return true;
+}
+
+
+bool
+delta_decoder::relayout(const ssr_delta& delta)
+{
+    std::unordered_map<int, const detected_object*> new_objects;
+    for (const ssr_object_delta& object_delta : delta.changed_objects)
+        new_objects.emplace(object_delta.id, &object_delta.instance);
+
+    // Previous index of each object in the new layout, or no_index for new objects
+    const std::size_t dim = delta.object_order.size();
+    std::vector<std::size_t> previous(dim, ::no_index);
+    std::vector<detected_object> objects(dim);
+
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+        const int id = delta.object_order[i];
+        const auto it = m_index_of.find(id);
+
+        if (it != m_index_of.end())
+        {
+            previous[i] = it->second;
+            objects[i] = std::move(m_objects[it->second]);
+        }
+        else if (const auto new_object = new_objects.find(id); new_object != new_objects.end())
+        {
+            objects[i] = *new_object->second;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    ssr::ssr_matrix ssr_matrix{dim};
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+        if (previous[i] == ::no_index) continue;
+
+        for (std::size_t j = 0; j < dim; ++j)
+        {
+            if (previous[j] != ::no_index)
+                ssr_matrix(i, j) = m_ssr_matrix(previous[i], previous[j]);
+        }
+    }
+
+    m_objects = std::move(objects);
+    m_ids = delta.object_order;
+    m_ssr_matrix = std::move(ssr_matrix);
+
+    m_index_of.clear();
+    for (std::size_t i = 0; i < dim; ++i)
+        m_index_of.emplace(m_ids[i], i);
+
+    return true;
+}
+
+
+bool
+delta_decoder::synchronised() const
+{
+    return m_synchronised;
+}
+
+
+const std::vector<detected_object>&
+delta_decoder::objects() const
+{
+    return m_objects;
+}
+
+
+const ssr::ssr_matrix&
+delta_decoder::matrix() const
+{
+    return m_ssr_matrix;
+}
+
+
+std::int64_t
+delta_decoder::timestamp() const
+{
+    return m_timestamp;
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// corcal
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief Default number of frames from one keyframe to the next in an SSR delta stream
+ */
+inline constexpr unsigned int default_keyframe_interval = 30;
+
+
+/**
+ * @brief Producer side of an SSR delta stream
+ *
+ * Turns consecutive frames of objects and SSR matrices into ssr_delta messages, which only contain the objects that
+ * appeared, changed or disappeared and the cells that changed since the previous frame.  Objects which only moved
+ * are sent as their bounding boxes.  Every keyframe_interval
+ * frames, a keyframe with the full state is emitted so that subscribers can join at any time and recover from lost
+ * messages.
+ *
+ * Objects are identified across frames by their instance name and get an id which is unique within the stream.
+ */
+class delta_encoder
+{
+
+    private:
+
+        unsigned int m_keyframe_interval;
+        unsigned int m_frames_since_keyframe;
+        std::int64_t m_sequence_number;
+        int m_next_id;
+
+        /**
+         * @brief State of the previous frame.  Keys are the instance names, made unique if necessary
+         */
+        std::vector<std::string> m_keys;
+        std::vector<int> m_ids;
+        std::vector<detected_object> m_objects;
+        ssr_matrix m_ssr_matrix;
+
+        std::unordered_map<std::string, std::size_t> m_previous_index;
+
+    public:
+
+        explicit delta_encoder(unsigned int keyframe_interval = default_keyframe_interval);
+
+        /**
+         * @brief Encodes the changes from the previous frame to the given one
+         */
+        ssr_delta encode(const std::vector<detected_object>& objects, const ssr_matrix& ssr_matrix,
+                         std::int64_t timestamp);
+
+        /**
+         * @brief Makes the next call to encode emit a keyframe
+         */
+        void request_keyframe();
+
+        unsigned int keyframe_interval() const;
+
+        void keyframe_interval(unsigned int);
+
+};
+
+
+/**
+ * @brief Subscriber side of an SSR delta stream, reconstructing the full objects and SSR matrix in the order of the
+ *        producer
+ */
+class delta_decoder
+{
+
+    private:
+
+        bool m_synchronised;
+        std::int64_t m_sequence_number;
+        std::int64_t m_timestamp;
+
+        std::vector<detected_object> m_objects;
+        std::vector<int> m_ids;
+        ssr_matrix m_ssr_matrix;
+
+        std::unordered_map<int, std::size_t> m_index_of;
+
+    public:
+
+        delta_decoder();
+
+        /**
+         * @brief Applies the given delta to the reconstructed state
+         * @return True if the state is valid afterwards.  False if a message was lost or the delta does not fit the
+         *         state, in which case all deltas are ignored until the next keyframe
+         */
+        bool apply(const ssr_delta& delta);
+
+        /**
+         * @brief Whether objects and matrix reflect the most recently applied delta
+         */
+        bool synchronised() const;
+
+        const std::vector<detected_object>& objects() const;
+
+        const ssr_matrix& matrix() const;
+
+        /**
+         * @brief Timestamp of the most recently applied delta
+         */
+        std::int64_t timestamp() const;
+
+    private:
+
+        /**
+         * @brief Rearranges objects and cells to the object order of the delta, dropping disappeared objects and
+         *        adding new ones
+         * @return False if the delta refers to unknown objects
+         */
+        bool relayout(const ssr_delta& delta);
+
+};
+
+
+}
@@ -0,0 +1,224 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/evaluation_cache.h>
+
+
+// STD/STL
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+
+using namespace corcal::core::ssr;
+
+
+namespace
+{
+    /**
+     * @brief Bound of the quantised coordinates, well within the range of std::int64_t
+     */
+    const double max_quantised = 1e18;
+
+
+    /**
+     * @brief Mixes value into seed (the finaliser of SplitMix64)
+     */
+    std::size_t
+    combine(std::size_t seed, std::uint64_t value)
+    {
+        std::uint64_t z = seed + 0x9e3779b97f4a7c15ull + value;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return static_cast<std::size_t>(z ^ (z >> 31));
+    }
+
+
+    std::int64_t
+    bits_of(float value)
+    {
+        std::int32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+
+    std::int64_t
+    bits_of(double value)
+    {
+        std::int64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+
+bool
+evaluation_cache::key::operator==(const key& other) const
+{
+    return hash == other.hash
+        and bits_of(distance_equality_threshold) == bits_of(other.distance_equality_threshold)
+        and coordinates == other.coordinates;
+}
+
+
+evaluation_cache::evaluation_cache(std::size_t capacity, float resolution) :
+    m_capacity{capacity},
+    m_resolution{resolution},
+    m_hits{0},
+    m_misses{0}
+{
+    ARMARX_CHECK_GREATER_EQUAL(resolution, 0);
+
+    // Keeps the iterators in m_recency valid, see there
+    m_entries.reserve(capacity + 1);
+}
+
+
+const ssr_matrix&
+evaluation_cache::evaluate(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold,
+    const evaluation_strategy strategy)
+{
+    key k;
+    if (m_capacity == 0 or not make_key(objects, distance_equality_threshold, k))
+    {
+        ++m_misses;
+        m_uncached = evaluate_relations(objects, distance_equality_threshold, strategy);
+        return m_uncached;
+    }
+
+    if (auto it = m_entries.find(k); it != m_entries.end())
+    {
+        ++m_hits;
+        m_recency.splice(m_recency.begin(), m_recency, it->second.recency);
+        return it->second.matrix;
+    }
+
+    ++m_misses;
+
+    if (m_entries.size() >= m_capacity)
+    {
+        m_entries.erase(m_recency.back());
+        m_recency.pop_back();
+    }
+
+    ssr_matrix matrix = evaluate_relations(objects, distance_equality_threshold, strategy);
+    auto [it, inserted] = m_entries.emplace(std::move(k), entry{std::move(matrix), {}});
+    m_recency.push_front(it);
+    it->second.recency = m_recency.begin();
+    return it->second.matrix;
+}
+
+
+void
+evaluation_cache::clear()
+{
+    m_entries.clear();
+    m_recency.clear();
+    m_entries.reserve(m_capacity + 1);
+}
+
+
+std::size_t
+evaluation_cache::size() const
+{
+    return m_entries.size();
+}
+
+
+std::size_t
+evaluation_cache::capacity() const
+{
+    return m_capacity;
+}
+
+
+float
+evaluation_cache::resolution() const
+{
+    return m_resolution;
+}
+
+
+std::size_t
+evaluation_cache::hits() const
+{
+    return m_hits;
+}
+
+
+std::size_t
+evaluation_cache::misses() const
+{
+    return m_misses;
+}
+
+
+void
+evaluation_cache::reset_counters()
+{
+    m_hits = 0;
+    m_misses = 0;
+}
+
+
+bool
+evaluation_cache::make_key(const std::vector<detected_object>& objects, double distance_equality_threshold,
+                           key& k) const
+{
+    k.coordinates.clear();
+    k.coordinates.reserve(objects.size() * 12);
+    k.distance_equality_threshold = distance_equality_threshold;
+    k.hash = combine(objects.size(), static_cast<std::uint64_t>(bits_of(distance_equality_threshold)));
+
+    for (const detected_object& object : objects)
+    {
+        for (const visionx::BoundingBox3D* bb : {&object.bounding_box, &object.past_bounding_box})
+        {
+            for (const float coordinate : {bb->x0, bb->y0, bb->z0, bb->x1, bb->y1, bb->z1})
+            {
+                std::int64_t quantised;
+                if (m_resolution == 0)
+                    quantised = bits_of(coordinate);
+                else
+                {
+                    // Also rejects NaN and infinity
+                    const double scaled = static_cast<double>(coordinate) / m_resolution;
+                    if (not (std::abs(scaled) < max_quantised))
+                        return false;
+                    quantised = std::llround(scaled);
+                }
+
+                k.coordinates.push_back(quantised);
+                k.hash = combine(k.hash, static_cast<std::uint64_t>(quantised));
+            }
+        }
+    }
+
+    return true;
+}
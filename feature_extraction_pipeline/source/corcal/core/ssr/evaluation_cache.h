@@ -0,0 +1,181 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// corcal
+#include <corcal/core/ssr/functions.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief Default number of SSR matrices an evaluation_cache holds
+ */
+inline constexpr std::size_t default_evaluation_cache_capacity = 256;
+
+
+/**
+ * @brief Default resolution in [mm] to which an evaluation_cache quantises bounding box coordinates
+ */
+inline constexpr float default_evaluation_cache_resolution = 1;
+
+
+/**
+ * @brief Least recently used memo cache in front of evaluate_relations
+ *
+ * Scenes are keyed by the current and past bounding boxes of all objects, in their order, quantised to the given
+ * resolution, together with the distance equality threshold.  Scenes which are identical up to the resolution thus
+ * share one SSR matrix.  With a resolution of 0, only scenes whose coordinates are bit-identical share one, and the
+ * results are identical to evaluate_relations.
+ *
+ * If a coordinate is not finite (or too large to be quantised) and the resolution is not 0, the scene is evaluated
+ * without being cached.  It still counts as a miss.
+ */
+class evaluation_cache
+{
+
+    private:
+
+        struct key
+        {
+            std::vector<std::int64_t> coordinates;
+            double distance_equality_threshold;
+            std::size_t hash;
+
+            bool operator==(const key& other) const;
+        };
+
+        struct key_hash
+        {
+            std::size_t operator()(const key& k) const
+            {
+                return k.hash;
+            }
+        };
+
+        struct entry;
+
+        using entry_map = std::unordered_map<key, entry, key_hash>;
+
+        struct entry
+        {
+            ssr_matrix matrix;
+
+            /**
+             * @brief Position of the entry in m_recency
+             */
+            std::list<entry_map::iterator>::iterator recency;
+        };
+
+        std::size_t m_capacity;
+        float m_resolution;
+
+        entry_map m_entries;
+
+        /**
+         * @brief Entries of m_entries, most recently used first
+         *
+         * A rehash would invalidate these iterators.  m_entries reserves buckets for capacity + 1 entries up front and
+         * never holds more than capacity, so it is never rehashed.
+         */
+        std::list<entry_map::iterator> m_recency;
+
+        /**
+         * @brief SSR matrix of the last uncached scene
+         */
+        ssr_matrix m_uncached;
+
+        std::size_t m_hits;
+        std::size_t m_misses;
+
+    public:
+
+        /**
+         * @param capacity Number of SSR matrices to hold before the least recently used one is evicted
+         * @param resolution Resolution in [mm] to which the bounding box coordinates are quantised, or 0
+         */
+        explicit evaluation_cache(std::size_t capacity = default_evaluation_cache_capacity,
+                                  float resolution = default_evaluation_cache_resolution);
+
+        /**
+         * @brief Returns the cached SSR matrix of the given scene, or evaluates and caches it with evaluate_relations
+         * @return SSR matrix in the order of objects, valid until the next call to evaluate or clear
+         */
+        const ssr_matrix& evaluate(
+            const std::vector<detected_object>& objects,
+            const double distance_equality_threshold,
+            const evaluation_strategy strategy = evaluation_strategy::fused
+        );
+
+        /**
+         * @brief Drops all cached SSR matrices.  The counters are kept
+         */
+        void clear();
+
+        /**
+         * @brief Number of cached SSR matrices
+         */
+        std::size_t size() const;
+
+        std::size_t capacity() const;
+
+        float resolution() const;
+
+        /**
+         * @brief Number of calls to evaluate which returned a cached SSR matrix
+         */
+        std::size_t hits() const;
+
+        /**
+         * @brief Number of calls to evaluate which evaluated the scene
+         */
+        std::size_t misses() const;
+
+        void reset_counters();
+
+    private:
+
+        /**
+         * @brief Builds the key of the given scene
+         * @return Whether the scene can be cached
+         */
+        bool make_key(const std::vector<detected_object>& objects, double distance_equality_threshold,
+                      key& k) const;
+
+};
+
+
+}
@@ -0,0 +1,200 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/event_generator.h>
+
+
+// STD/STL
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+// corcal
+#include <corcal/core/ssr/functions.h>
+
+
+using namespace corcal::core;
+using namespace corcal::core::ssr;
+
+
+namespace
+{
+    const std::size_t no_index = corcal::core::ssr::no_previous_index;
+
+    /**
+     * @brief Number of 16 bit cells per 64 bit word
+     */
+    const std::size_t cells_per_word = 4;
+
+    static_assert(sizeof(relations) * cells_per_word == sizeof(std::uint64_t));
+
+
+    /**
+     * @brief Loads up to four consecutive cells into one word, padding with empty cells
+     */
+    std::uint64_t
+    load_word(const relations* cells, std::size_t count)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, cells, count * sizeof(relations));
+        return word;
+    }
+
+
+    std::uint64_t
+    broadcast(std::uint16_t mask)
+    {
+        return std::uint64_t{mask} * 0x0001'0001'0001'0001ull;
+    }
+
+
+    /**
+     * @brief Appends one event per set bit of each cell of onsets and offsets
+     */
+    void
+    append_events(
+        std::vector<ssr_relation_event>& events,
+        std::uint64_t onsets,
+        std::uint64_t offsets,
+        const std::string& subject_instance_name,
+        const std::vector<std::string>& object_instance_names,
+        std::size_t first_object_index,
+        std::int64_t timestamp)
+    {
+        for (std::size_t lane = 0; lane < cells_per_word; ++lane)
+        {
+            const auto onset_mask = static_cast<std::uint16_t>(onsets >> (16 * lane));
+            const auto offset_mask = static_cast<std::uint16_t>(offsets >> (16 * lane));
+            if ((onset_mask | offset_mask) == 0)
+                continue;
+
+            const std::string& object_instance_name = object_instance_names[first_object_index + lane];
+            for (const relation rel : relation_range<relation>{static_cast<std::uint16_t>(onset_mask | offset_mask)})
+            {
+                events.push_back(ssr_relation_event{subject_instance_name, object_instance_name,
+                                                    static_cast<int>(rel), (onset_mask & mask_of(rel)) != 0,
+                                                    timestamp});
+            }
+        }
+    }
+}
+
+
+event_generator::event_generator(std::uint16_t relations_mask) :
+    m_relations_mask{relations_mask}
+{
+    // pass
+}
+
+
+std::vector<ssr_relation_event>
+event_generator::generate(
+    const std::vector<detected_object>& objects,
+    const ssr::ssr_matrix& ssr_matrix,
+    std::int64_t timestamp)
+{
+    ARMARX_CHECK_EQUAL_W_HINT(objects.size(), ssr_matrix.dim(), "SSR matrix does not match the objects");
+
+    const std::size_t dim = objects.size();
+    const std::vector<std::string> keys = ssr::instance_keys(objects);
+    std::vector<std::string> instance_names;
+    instance_names.reserve(dim);
+    for (const detected_object& object : objects)
+        instance_names.push_back(object.instance_name);
+
+    const auto [previous, still_present] = ssr::match_previous_frame(keys, m_keys, m_previous_index);
+
+    std::vector<ssr_relation_event> events;
+    const std::uint64_t relations_mask = ::broadcast(m_relations_mask);
+    m_previous_row.resize(dim);
+
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+        // Previous row of the subject in the current object order.  Cells of new objects were empty
+        for (std::size_t j = 0; j < dim; ++j)
+        {
+            m_previous_row[j] = previous[i] != ::no_index and previous[j] != ::no_index
+                ? m_ssr_matrix(previous[i], previous[j]) : relations{};
+        }
+
+        const relations* current_row = ssr_matrix.data() + i * dim;
+        for (std::size_t j = 0; j < dim; j += ::cells_per_word)
+        {
+            const std::size_t count = std::min(::cells_per_word, dim - j);
+            const std::uint64_t current = ::load_word(current_row + j, count);
+            const std::uint64_t before = ::load_word(m_previous_row.data() + j, count);
+
+            if (((current ^ before) & relations_mask) == 0)
+                continue;
+
+            ::append_events(events, current & ~before & relations_mask, before & ~current & relations_mask,
+                            instance_names[i], instance_names, j, timestamp);
+        }
+    }
+
+    // Offsets of all relations of disappeared objects
+    for (std::size_t i = 0; i < m_keys.size(); ++i) for (std::size_t j = 0; j < m_keys.size(); ++j)
+    {
+        if (still_present[i] and still_present[j])
+            continue;
+
+        const std::uint16_t offsets = static_cast<std::uint16_t>(m_ssr_matrix(i, j).mask() & m_relations_mask);
+        for (const relation rel : relation_range<relation>{offsets})
+        {
+            events.push_back(ssr_relation_event{m_instance_names[i], m_instance_names[j], static_cast<int>(rel),
+                                                false, timestamp});
+        }
+    }
+
+    m_keys = keys;
+    m_instance_names = std::move(instance_names);
+    m_ssr_matrix = ssr_matrix;
+
+    return events;
+}
+
+
+void
+event_generator::reset()
+{
+    m_keys.clear();
+    m_instance_names.clear();
+    m_ssr_matrix.reset(0);
+}
+
+
+std::uint16_t
+event_generator::relations_mask() const
+{
+    return m_relations_mask;
+}
+
+
+void
+event_generator::relations_mask(std::uint16_t relations_mask)
+{
+    m_relations_mask = relations_mask;
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// corcal
+#include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief Turns consecutive frames of objects and SSR matrices into onset and offset events of relations
+ *
+ * Keeps the relations of the previous frame per pair of instances.  A relation that is active now but was not before
+ * yields an onset, one that was active before but is not any more an offset.  Objects are identified across frames
+ * by their instance keys (see instance_keys), so the order of the objects may change from frame to frame.  Relations of
+ * objects which appear have their onset, relations of objects which disappear have their offset.
+ *
+ * Each row is compared to the previous frame four cells per 64 bit word, by XOR to skip unchanged cells and AND-NOT to
+ * tell onsets from offsets.
+ */
+class event_generator
+{
+
+    private:
+
+        std::uint16_t m_relations_mask;
+
+        /**
+         * @brief State of the previous frame
+         */
+        std::vector<std::string> m_keys;
+        std::vector<std::string> m_instance_names;
+        ssr_matrix m_ssr_matrix;
+
+        std::unordered_map<std::string, std::size_t> m_previous_index;
+
+        /**
+         * @brief Scratch row with the previous relations of a subject, in the object order of the current frame
+         */
+        std::vector<relations> m_previous_row;
+
+    public:
+
+        /**
+         * @param relations_mask Relations to generate events for, all by default
+         */
+        explicit event_generator(std::uint16_t relations_mask = all_relations_mask);
+
+        /**
+         * @brief Events from the previous frame to the given one, ordered by subject, object and relation bit of the
+         *        given frame.  Events of disappeared objects come last
+         */
+        std::vector<ssr_relation_event> generate(const std::vector<detected_object>& objects,
+                                                 const ssr_matrix& ssr_matrix, std::int64_t timestamp);
+
+        /**
+         * @brief Forgets the previous frame, so that the next one yields onsets for all its relations
+         */
+        void reset();
+
+        std::uint16_t relations_mask() const;
+
+        void relations_mask(std::uint16_t);
+
+};
+
+
+}
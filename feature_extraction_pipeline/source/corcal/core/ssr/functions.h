@@ -24,8 +24,21 @@
 #pragma once
 
 
+// STD/STL
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// VisionX
+#include <VisionX/interface/core/DataTypes.h>
+
 // corcal
+#include <corcal/core/ssr/object_series.h>
 #include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
 #include <corcal/interface/data_structures.h>
 
 
@@ -33,8 +46,213 @@ namespace corcal::core::ssr
 {
 
 
-std::vector<std::vector<relations>>
+/**
+ * @brief Strategies to evaluate an SSR matrix, which all yield bit-identical results
+ */
+enum class evaluation_strategy
+{
+    /**
+     * @brief Single pass over all pairs after precomputing per-object centroids and self-motion
+     */
+    fused,
+
+    /**
+     * @brief Separate passes for contact, static and dynamic relations (reference implementation)
+     */
+    three_pass,
+
+    /**
+     * @brief Contact and static relations by the batched SIMD kernel, followed by the fused dynamic relations pass
+     */
+    batched,
+
+    /**
+     * @brief Fixed-capacity evaluator of the smallest fitting small_scene (up to 64 objects), fused beyond
+     */
+    small_scene,
+
+    /**
+     * @brief Contact and static relations by the sweep-and-prune broad phase (see evaluate_static_relations_sweep),
+     *        followed by the fused dynamic relations pass.  Pays off for large scenes with few touching objects
+     */
+    sweep
+};
+
+
+/**
+ * @brief Instruction sets available to the batched kernels, ordered by capability
+ */
+enum class instruction_set
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512
+};
+
+
+/**
+ * @brief Detects the most capable instruction set of the running CPU
+ */
+instruction_set
+detect_instruction_set();
+
+
+bool
+is_supported(const instruction_set isa);
+
+
+std::string
+to_string(const instruction_set isa);
+
+
+/**
+ * @brief Evaluates all relations between the given objects with the given strategy
+ */
+ssr_matrix
 evaluate_relations(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold,
+    const evaluation_strategy strategy = evaluation_strategy::fused
+);
+
+
+ssr_matrix
+evaluate_relations_fused(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold
+);
+
+
+/**
+ * @brief Fused evaluation of count objects given by their current and past bounding boxes, for example one frame of
+ *        an object_series
+ */
+ssr_matrix
+evaluate_relations_fused(
+    const visionx::BoundingBox3D* bounding_boxes,
+    const visionx::BoundingBox3D* past_bounding_boxes,
+    const std::size_t count,
+    const double distance_equality_threshold
+);
+
+
+/**
+ * @brief Evaluates the SSR matrices of the given objects for several distance equality thresholds at once
+ *
+ * Contact and static relations, collisions and the distance changes of all pairs are computed once and shared by all
+ * thresholds.  Only the comparisons against each threshold are repeated.  Element k equals
+ * evaluate_relations(objects, distance_equality_thresholds[k]).
+ *
+ * @return One SSR matrix per threshold, in the order of distance_equality_thresholds
+ */
+std::vector<ssr_matrix>
+evaluate_relations_thresholds(
+    const std::vector<detected_object>& objects,
+    const std::vector<double>& distance_equality_thresholds
+);
+
+
+/**
+ * @brief Evaluates the dynamic relations of the given objects for each of their past horizons at once, that is for
+ *        each entry of detected_object::past_bounding_boxes
+ *
+ * Current centroids and collisions are computed once and shared by all horizons.  All objects must carry the same
+ * number of past bounding boxes.  Element h equals the dynamic relations of evaluate_relations if past_bounding_box
+ * was past_bounding_boxes[h].
+ *
+ * @return One SSR matrix per horizon, holding only dynamic relations
+ */
+std::vector<ssr_matrix>
+evaluate_dynamic_relations_horizons(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold
+);
+
+
+/**
+ * @brief Pairs considered by evaluate_relations_hand_centric
+ */
+struct hand_centric_options
+{
+    /**
+     * @brief Class names of the objects which are hands
+     */
+    std::vector<std::string> hand_class_names{"LeftHand", "RightHand"};
+
+    /**
+     * @brief Distance in [mm] between bounding boxes up to which an object is in the neighbourhood of a hand
+     */
+    float neighbourhood_distance = 100;
+
+    /**
+     * @brief Number of nearest objects which are in the neighbourhood of each hand regardless of their distance
+     */
+    std::size_t nearest_neighbours = 2;
+};
+
+
+/**
+ * @brief Evaluates only the pairs which matter for bimanual actions: each hand with every other object, and all pairs
+ *        of objects in the neighbourhood of a hand
+ *
+ * The neighbourhood of a hand holds the objects within options.neighbourhood_distance of it, and its
+ * options.nearest_neighbours nearest objects.  Each evaluated cell equals the one of evaluate_relations.
+ *
+ * @return Non-empty cells of the evaluated pairs in both directions, ordered by subject and object index
+ */
+ssr_sparse_cell_list
+evaluate_relations_hand_centric(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold,
+    const hand_centric_options& options = hand_centric_options{}
+);
+
+
+/**
+ * @brief Evaluates all relations between a single pair of objects, given by their current and past bounding boxes
+ *
+ * Yields the cells [subject][object] and [object][subject] exactly as evaluate_relations would if subject had the
+ * lower index.  The relations are ORed into the given cells.
+ */
+void
+evaluate_pair(
+    const visionx::BoundingBox3D& subject_bb,
+    const visionx::BoundingBox3D& subject_past_bb,
+    const visionx::BoundingBox3D& object_bb,
+    const visionx::BoundingBox3D& object_past_bb,
+    const double distance_equality_threshold,
+    relations& subject_to_object,
+    relations& object_to_subject
+);
+
+
+/**
+ * @brief Evaluates the SSR matrices of all frames of a recording in parallel
+ *
+ * Each frame only depends on its own current and past bounding boxes, so frames are distributed over a pool of
+ * thread_count worker threads (one per hardware thread if 0).
+ *
+ * @return One SSR matrix per frame, in frame order
+ */
+std::vector<ssr_matrix>
+evaluate_relations_series(
+    const object_series& series,
+    const double distance_equality_threshold,
+    const unsigned int thread_count = 0
+);
+
+
+std::vector<ssr_matrix>
+evaluate_relations_series(
+    const std::vector<std::vector<detected_object>>& frames,
+    const double distance_equality_threshold,
+    const unsigned int thread_count = 0
+);
+
+
+ssr_matrix
+evaluate_relations_three_pass(
     const std::vector<detected_object>& objects,
     const double distance_equality_threshold
 );
@@ -43,31 +261,152 @@ evaluate_relations(
 void
 evaluate_contact_relations(
     const std::vector<detected_object>& objects,
-    std::vector<std::vector<relations>>& ssr_matrix
+    ssr_matrix& ssr_matrix
 );
 
 
 void
 evaluate_static_relations(
     const std::vector<detected_object>& objects,
-    std::vector<std::vector<relations>>& ssr_matrix
+    ssr_matrix& ssr_matrix
+);
+
+
+/**
+ * @brief Evaluates contact and static relations by testing each subject against batches of 4 (SSE2), 8 (AVX2) or
+ *        16 (AVX-512) objects at once, from a structure-of-arrays copy of the bounding boxes
+ *
+ * Equivalent to evaluate_contact_relations followed by evaluate_static_relations.
+ */
+void
+evaluate_static_relations_batched(
+    const std::vector<detected_object>& objects,
+    ssr_matrix& ssr_matrix,
+    const instruction_set isa = detect_instruction_set()
+);
+
+
+/**
+ * @brief Finds all pairs (i, j), i < j, of colliding bounding boxes (in the sense of TNR in the paper) by sweep and
+ *        prune along the axis of the greatest spread, in roughly O(N log N + K)
+ *
+ * All boxes must be valid, that is x0 <= x1, y0 <= y1 and z0 <= z1.
+ */
+std::vector<std::pair<std::size_t, std::size_t>>
+find_overlapping_pairs(const std::vector<visionx::BoundingBox3D>& boxes);
+
+
+/**
+ * @brief Evaluates contact and static relations using find_overlapping_pairs as broad phase for contact, inside and
+ *        surround, and the rank order of the interval bounds for the directional relations
+ *
+ * Equivalent to evaluate_contact_relations followed by evaluate_static_relations.  Falls back to these if any
+ * bounding box is not valid.
+ */
+void
+evaluate_static_relations_sweep(
+    const std::vector<detected_object>& objects,
+    ssr_matrix& ssr_matrix
 );
 
 
 void
 evaluate_dynamic_relations(
     const std::vector<detected_object>& objects,
-    std::vector<std::vector<relations>>& ssr_matrix,
+    ssr_matrix& ssr_matrix,
     const double distance_equality_threshold
 );
 
 
+/**
+ * @brief Adds the dynamic relations with the per-pair decisions of the fused pass (kernel::evaluate_dynamic_pair)
+ *
+ * Equivalent to evaluate_dynamic_relations, without its per-cell bounds checks.
+ */
+void
+evaluate_dynamic_relations_fused(
+    const std::vector<detected_object>& objects,
+    ssr_matrix& ssr_matrix,
+    const double distance_equality_threshold
+);
+
+
+/**
+ * @brief Keys identifying the given objects across frames: their instance names, where repeated names are made unique
+ *        by their occurrence count ("name", "name#1", ...)
+ */
+std::vector<std::string>
+instance_keys(const std::vector<detected_object>& objects);
+
+
+/**
+ * @brief Index of objects which were not present in the previous frame
+ */
+inline constexpr std::size_t no_previous_index = std::numeric_limits<std::size_t>::max();
+
+
+/**
+ * @brief Correspondence of the objects of a frame to the objects of the previous frame
+ */
+struct previous_frame_match
+{
+    /**
+     * @brief Index of each object in the previous frame, or no_previous_index if it appeared
+     */
+    std::vector<std::size_t> previous;
+
+    /**
+     * @brief Whether each object of the previous frame is still present
+     */
+    std::vector<bool> still_present;
+};
+
+
+/**
+ * @brief Finds each object in the previous frame by its instance key (see instance_keys)
+ * @param previous_index Scratch index from key to previous index, which is cleared and refilled.  Callers keep it
+ *        across frames to reuse its buckets
+ */
+previous_frame_match
+match_previous_frame(
+    const std::vector<std::string>& keys,
+    const std::vector<std::string>& previous_keys,
+    std::unordered_map<std::string, std::size_t>& previous_index
+);
+
+
 std::vector<std::vector<int>>
-serialise(const std::vector<std::vector<relations>>& ssr_matrix);
+serialise(const ssr_matrix& ssr_matrix);
 
 
-std::vector<std::vector<relations>>
+ssr_matrix
 unserialise(const std::vector<std::vector<int>>& ssr_matrix);
 
 
+/**
+ * @brief Packs the SSR matrix for the wire: Only the cells above the diagonal are kept, 16 bit each, in row-major
+ *        order.  If run_length_encode is set, runs of empty cells are replaced by a single word with bit 7 set (a bit
+ *        no relation uses) and the run length in the remaining 15 bits
+ *
+ * The matrix must be antisymmetric in the sense that [j][i] equals [i][j].inverse(), which holds for all matrices
+ * obtained from evaluate_relations.  This is not checked here, the cells below the diagonal are simply not read.
+ */
+ssr_matrix_packed
+pack(const ssr_matrix& ssr_matrix, const bool run_length_encode = true);
+
+
+/**
+ * @brief Unpacks a packed SSR matrix, rebuilding the cells below the diagonal with relations::inverse
+ */
+ssr_matrix
+unpack(const ssr_matrix_packed& ssr_matrix);
+
+
+/**
+ * @brief Expands the cells of a sparse SSR matrix to a dense dim×dim matrix, where all other cells are empty
+ */
+ssr_matrix
+unpack(const ssr_sparse_cell_list& cells, const std::size_t dim);
+
+
 }
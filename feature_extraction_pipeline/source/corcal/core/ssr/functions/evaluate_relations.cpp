@@ -26,7 +26,9 @@
 
 // STD/STL
 #include <cmath>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 // ArmarX
 #include <ArmarXCore/core/logging/Logging.h>
@@ -36,7 +38,10 @@
 #include <VisionX/interface/core/DataTypes.h>
 
 // corcal
+#include <corcal/core/ssr/kernel.h>
 #include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/small_scene.h>
+#include <corcal/core/ssr/ssr_matrix.h>
 #include <corcal/interface/data_structures.h>
 
 
@@ -93,15 +98,80 @@ namespace
             + std::to_string(distance) + ")");
         return distance;
     }
+
+
+    kernel::box<float>
+    box_of(const bounding_box& bb)
+    {
+        return kernel::box<float>{bb.x0, bb.y0, bb.z0, bb.x1, bb.y1, bb.z1};
+    }
+
+
+    const bounding_box&
+    current_bounding_box(const detected_object& object)
+    {
+        return object.bounding_box;
+    }
+
+
+    const bounding_box&
+    past_bounding_box(const detected_object& object)
+    {
+        return object.past_bounding_box;
+    }
+
+
+    const bounding_box&
+    identity(const bounding_box& bb)
+    {
+        return bb;
+    }
 }
 
 
-std::vector<std::vector<relations>>
+ssr::ssr_matrix
 ssr::evaluate_relations(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold,
+    const evaluation_strategy strategy)
+{
+    switch (strategy)
+    {
+        case evaluation_strategy::fused:
+            return ssr::evaluate_relations_fused(objects, distance_equality_threshold);
+        case evaluation_strategy::three_pass:
+            return ssr::evaluate_relations_three_pass(objects, distance_equality_threshold);
+        case evaluation_strategy::batched:
+        {
+            ssr::ssr_matrix ssr_matrix{objects.size()};
+            ssr::evaluate_static_relations_batched(objects, ssr_matrix);
+            ssr::evaluate_dynamic_relations_fused(objects, ssr_matrix, distance_equality_threshold);
+            return ssr_matrix;
+        }
+        case evaluation_strategy::small_scene:
+            return ssr::evaluate_relations_small_scene(kernel::project_boxes(objects, ::current_bounding_box),
+                                                       kernel::project_boxes(objects, ::past_bounding_box),
+                                                       distance_equality_threshold);
+        case evaluation_strategy::sweep:
+        {
+            ssr::ssr_matrix ssr_matrix{objects.size()};
+            ssr::evaluate_static_relations_sweep(objects, ssr_matrix);
+            ssr::evaluate_dynamic_relations_fused(objects, ssr_matrix, distance_equality_threshold);
+            return ssr_matrix;
+        }
+    }
+
+    ARMARX_CHECK_EXPRESSION_W_HINT(false, "Unknown SSR evaluation strategy");
+    return ssr::ssr_matrix{};
+}
+
+
+ssr::ssr_matrix
+ssr::evaluate_relations_three_pass(
     const std::vector<detected_object>& objects,
     const double distance_equality_threshold)
 {
-    std::vector<std::vector<relations>> ssr_matrix{objects.size(), std::vector<relations>(objects.size())};
+    ssr::ssr_matrix ssr_matrix{objects.size()};
 
     ssr::evaluate_contact_relations(objects, ssr_matrix);
     ssr::evaluate_static_relations(objects, ssr_matrix);
@@ -111,10 +181,239 @@ ssr::evaluate_relations(
 }
 
 
+ssr::ssr_matrix
+ssr::evaluate_relations_fused(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold)
+{
+    return kernel::evaluate_relations(kernel::project_boxes(objects, ::current_bounding_box),
+                                      kernel::project_boxes(objects, ::past_bounding_box),
+                                      distance_equality_threshold);
+}
+
+
+ssr::ssr_matrix
+ssr::evaluate_relations_fused(
+    const bounding_box* bounding_boxes,
+    const bounding_box* past_bounding_boxes,
+    const std::size_t count,
+    const double distance_equality_threshold)
+{
+    return kernel::evaluate_relations(kernel::projected_boxes{bounding_boxes, count, ::identity},
+                                      kernel::projected_boxes{past_bounding_boxes, count, ::identity},
+                                      distance_equality_threshold);
+}
+
+
+std::vector<ssr::ssr_matrix>
+ssr::evaluate_relations_thresholds(
+    const std::vector<detected_object>& objects,
+    const std::vector<double>& distance_equality_thresholds)
+{
+    const std::size_t dim = objects.size();
+
+    // Per-object precomputation: centroids and the distance each object moved (compared against half the threshold)
+    std::vector<kernel::centroid<float>> centres;
+    std::vector<kernel::centroid<float>> past_centres;
+    std::vector<double> self_motion;
+    centres.reserve(dim);
+    past_centres.reserve(dim);
+    self_motion.reserve(dim);
+    for (const detected_object& object : objects)
+    {
+        centres.push_back(kernel::centroid_of(::box_of(object.bounding_box)));
+        past_centres.push_back(kernel::centroid_of(::box_of(object.past_bounding_box)));
+        self_motion.push_back(kernel::distance_between(centres.back(), past_centres.back()));
+    }
+
+    // Per-pair precomputation, in the iteration order of the fused pass: contact and static relations go straight
+    // into a base matrix shared by all thresholds, the dynamic relations only need to know whether the pair
+    // collided now and before, and by how much their distance changed
+    enum class pair_state : unsigned char
+    {
+        colliding_both,
+        colliding_neither,
+        colliding_once
+    };
+
+    ssr::ssr_matrix base{dim};
+    std::vector<pair_state> pair_states;
+    std::vector<double> distance_changes;
+    pair_states.reserve(dim * dim / 2);
+    distance_changes.reserve(dim * dim / 2);
+    for (std::size_t subject_index = 0; subject_index < dim; ++subject_index)
+    {
+        const detected_object& subject = objects[subject_index];
+        for (std::size_t object_index = subject_index + 1; object_index < dim; ++object_index)
+        {
+            const detected_object& object = objects[object_index];
+            const kernel::box<float> subject_bb = ::box_of(subject.bounding_box);
+            const kernel::box<float> object_bb = ::box_of(object.bounding_box);
+
+            const bool colliding = kernel::is_colliding(subject_bb, object_bb);
+            const bool colliding_past = kernel::is_colliding(::box_of(subject.past_bounding_box),
+                                                             ::box_of(object.past_bounding_box));
+
+            kernel::evaluate_static_pair(subject_bb, object_bb, colliding, base(subject_index, object_index),
+                                         base(object_index, subject_index));
+
+            double distance_change = 0;
+            if (colliding and colliding_past)
+            {
+                pair_states.push_back(pair_state::colliding_both);
+            }
+            else if (not colliding and not colliding_past)
+            {
+                pair_states.push_back(pair_state::colliding_neither);
+                const double delta = kernel::distance_between(centres[subject_index], centres[object_index]);
+                const double delta_past = kernel::distance_between(past_centres[subject_index],
+                                                                   past_centres[object_index]);
+                distance_change = delta - delta_past;
+            }
+            else
+            {
+                pair_states.push_back(pair_state::colliding_once);
+            }
+            distance_changes.push_back(distance_change);
+        }
+    }
+
+    // Per threshold, only the comparisons remain
+    std::vector<ssr::ssr_matrix> ssr_matrices;
+    ssr_matrices.reserve(distance_equality_thresholds.size());
+    std::vector<bool> stood_still(dim);
+    for (const double distance_equality_threshold : distance_equality_thresholds)
+    {
+        for (std::size_t index = 0; index < dim; ++index)
+            stood_still[index] = self_motion[index] < (distance_equality_threshold / 2);
+
+        ssr::ssr_matrix& ssr_matrix = ssr_matrices.emplace_back(base);
+
+        std::size_t pair_index = 0;
+        for (std::size_t subject_index = 0; subject_index < dim; ++subject_index)
+        {
+            for (std::size_t object_index = subject_index + 1; object_index < dim; ++object_index, ++pair_index)
+            {
+                if (pair_states[pair_index] == pair_state::colliding_once)
+                    continue;
+
+                const relation dynamic_relation = pair_states[pair_index] == pair_state::colliding_both
+                    ? kernel::colliding_dynamic_relation(stood_still[subject_index], stood_still[object_index])
+                    : kernel::separate_dynamic_relation(distance_changes[pair_index], distance_equality_threshold);
+
+                // Dynamic relations are commutative
+                ssr_matrix(subject_index, object_index).set(dynamic_relation, true);
+                ssr_matrix(object_index, subject_index).set(dynamic_relation, true);
+            }
+        }
+    }
+
+    return ssr_matrices;
+}
+
+
+std::vector<ssr::ssr_matrix>
+ssr::evaluate_dynamic_relations_horizons(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold)
+{
+    const std::size_t dim = objects.size();
+    const std::size_t horizon_count = objects.empty() ? 0 : objects.front().past_bounding_boxes.size();
+
+    // Per-object precomputation: the current centroid once, the past centroid and whether the object stood still
+    // once per horizon (object-major)
+    std::vector<kernel::centroid<float>> centres;
+    std::vector<kernel::centroid<float>> past_centres;
+    std::vector<bool> stood_still;
+    centres.reserve(dim);
+    past_centres.reserve(dim * horizon_count);
+    stood_still.reserve(dim * horizon_count);
+    for (const detected_object& object : objects)
+    {
+        ARMARX_CHECK_EQUAL(object.past_bounding_boxes.size(), horizon_count);
+
+        centres.push_back(kernel::centroid_of(::box_of(object.bounding_box)));
+        for (const bounding_box& past_bb : object.past_bounding_boxes)
+        {
+            past_centres.push_back(kernel::centroid_of(::box_of(past_bb)));
+            stood_still.push_back(
+                kernel::distance_between(centres.back(), past_centres.back()) < (distance_equality_threshold / 2));
+        }
+    }
+
+    std::vector<ssr::ssr_matrix> ssr_matrices(horizon_count, ssr::ssr_matrix{dim});
+
+    // Per pair, the current collision and distance are shared by all horizons
+    for (std::size_t subject_index = 0; subject_index < dim; ++subject_index)
+    {
+        const detected_object& subject = objects[subject_index];
+        for (std::size_t object_index = subject_index + 1; object_index < dim; ++object_index)
+        {
+            const detected_object& object = objects[object_index];
+
+            const bool colliding = kernel::is_colliding(::box_of(subject.bounding_box), ::box_of(object.bounding_box));
+            const double delta = colliding ? 0 : kernel::distance_between(centres[subject_index],
+                                                                          centres[object_index]);
+
+            for (std::size_t horizon = 0; horizon < horizon_count; ++horizon)
+            {
+                const std::size_t subject_past = subject_index * horizon_count + horizon;
+                const std::size_t object_past = object_index * horizon_count + horizon;
+                const bool colliding_past = kernel::is_colliding(::box_of(subject.past_bounding_boxes[horizon]),
+                                                                 ::box_of(object.past_bounding_boxes[horizon]));
+
+                relation dynamic_relation;
+                if (colliding and colliding_past)
+                {
+                    dynamic_relation = kernel::colliding_dynamic_relation(stood_still[subject_past],
+                                                                          stood_still[object_past]);
+                }
+                else if (not colliding and not colliding_past)
+                {
+                    const double delta_past = kernel::distance_between(past_centres[subject_past],
+                                                                       past_centres[object_past]);
+                    dynamic_relation = kernel::separate_dynamic_relation(delta - delta_past,
+                                                                         distance_equality_threshold);
+                }
+                else
+                {
+                    continue;
+                }
+
+                // Dynamic relations are commutative
+                ssr_matrices[horizon](subject_index, object_index).set(dynamic_relation, true);
+                ssr_matrices[horizon](object_index, subject_index).set(dynamic_relation, true);
+            }
+        }
+    }
+
+    return ssr_matrices;
+}
+
+
+void
+ssr::evaluate_pair(
+    const bounding_box& subject_bb,
+    const bounding_box& subject_past_bb,
+    const bounding_box& object_bb,
+    const bounding_box& object_past_bb,
+    const double distance_equality_threshold,
+    relations& subject_to_object,
+    relations& object_to_subject)
+{
+    const kernel::object_summary<float> subject
+        = kernel::summarise(::box_of(subject_bb), ::box_of(subject_past_bb), distance_equality_threshold);
+    const kernel::object_summary<float> object
+        = kernel::summarise(::box_of(object_bb), ::box_of(object_past_bb), distance_equality_threshold);
+
+    kernel::evaluate_pair(subject, object, distance_equality_threshold, subject_to_object, object_to_subject);
+}
+
+
 void
 ssr::evaluate_contact_relations(
     const std::vector<detected_object>& objects,
-    std::vector<std::vector<relations>>& ssr_matrix)
+    ssr::ssr_matrix& ssr_matrix)
 {
     const unsigned long dim = objects.size();
 
@@ -153,9 +452,9 @@ ssr::evaluate_contact_relations(
 
             if (::is_colliding(subject_bb, object_bb))
             {
-                ssr_matrix.at(subject_index).at(object_index).contact(true);
+                ssr_matrix(subject_index, object_index).contact(true);
                 // <=>
-                ssr_matrix.at(object_index).at(subject_index).contact(true);
+                ssr_matrix(object_index, subject_index).contact(true);
             }
         }
     }
@@ -165,7 +464,7 @@ ssr::evaluate_contact_relations(
 void
 ssr::evaluate_static_relations(
     const std::vector<detected_object>& objects,
-    std::vector<std::vector<relations>>& ssr_matrix)
+    ssr::ssr_matrix& ssr_matrix)
 {
     const unsigned long dim = objects.size();
 
@@ -208,51 +507,51 @@ ssr::evaluate_static_relations(
             if (subject_bb.x1 < object_bb.x0)
             {
                 ARMARX_VERBOSE << "Found SSR: " << subject.class_name << " is left of " << object.class_name;
-                ssr_matrix.at(subject_index).at(object_index).static_left_of(true);
+                ssr_matrix(subject_index, object_index).static_left_of(true);
                 // =>
-                ssr_matrix.at(object_index).at(subject_index).static_right_of(true);
+                ssr_matrix(object_index, subject_index).static_right_of(true);
             }
             // Right
             else if (subject_bb.x0 > object_bb.x1)
             {
                 ARMARX_VERBOSE << "Found SSR: " << subject.class_name << " is right of " << object.class_name;
-                ssr_matrix.at(subject_index).at(object_index).static_right_of(true);
+                ssr_matrix(subject_index, object_index).static_right_of(true);
                 // =>
-                ssr_matrix.at(object_index).at(subject_index).static_left_of(true);
+                ssr_matrix(object_index, subject_index).static_left_of(true);
             }
 
             // Below
             if (subject_bb.y1 < object_bb.y0)
             {
                 ARMARX_VERBOSE << "Found SSR: " << subject.class_name << " is below of " << object.class_name;
-                ssr_matrix.at(subject_index).at(object_index).static_below(true);
+                ssr_matrix(subject_index, object_index).static_below(true);
                 // =>
-                ssr_matrix.at(object_index).at(subject_index).static_above(true);
+                ssr_matrix(object_index, subject_index).static_above(true);
             }
             // Above
             else if (subject_bb.y0 > object_bb.y1)
             {
                 ARMARX_VERBOSE << "Found SSR: " << subject.class_name << " is above of " << object.class_name;
-                ssr_matrix.at(subject_index).at(object_index).static_above(true);
+                ssr_matrix(subject_index, object_index).static_above(true);
                 // =>
-                ssr_matrix.at(object_index).at(subject_index).static_below(true);
+                ssr_matrix(object_index, subject_index).static_below(true);
             }
 
             // Behind
             if (subject_bb.z1 < object_bb.z0)
             {
                 ARMARX_VERBOSE << "Found SSR: " << subject.class_name << " is behind of " << object.class_name;
-                ssr_matrix.at(subject_index).at(object_index).static_behind_of(true);
+                ssr_matrix(subject_index, object_index).static_behind_of(true);
                 // =>
-                ssr_matrix.at(object_index).at(subject_index).static_in_front_of(true);
+                ssr_matrix(object_index, subject_index).static_in_front_of(true);
             }
             // In front
             else if (subject_bb.z0 > object_bb.z1)
             {
                 ARMARX_VERBOSE << "Found SSR: " << subject.class_name << " is in front of " << object.class_name;
-                ssr_matrix.at(subject_index).at(object_index).static_in_front_of(true);
+                ssr_matrix(subject_index, object_index).static_in_front_of(true);
                 // =>
-                ssr_matrix.at(object_index).at(subject_index).static_behind_of(true);
+                ssr_matrix(object_index, subject_index).static_behind_of(true);
             }
 
             // Inside
@@ -260,18 +559,18 @@ ssr::evaluate_static_relations(
                 and subject_bb.z1 < object_bb.z1 and object_bb.y0 < subject_bb.y0 and subject_bb.y0 <= object_bb.y1)
             {
                 ARMARX_VERBOSE << "Found SSR: " << subject.class_name << " is inside of " << object.class_name;
-                ssr_matrix.at(subject_index).at(object_index).static_inside(true);
+                ssr_matrix(subject_index, object_index).static_inside(true);
                 // =>
-                ssr_matrix.at(object_index).at(subject_index).static_surround(true);
+                ssr_matrix(object_index, subject_index).static_surround(true);
             }
             // Surround
             else if (object_bb.x0 > subject_bb.x0 and subject_bb.x1 > object_bb.x1 and object_bb.z0 > subject_bb.z0
                 and subject_bb.z1 > object_bb.z1 and object_bb.y0 > subject_bb.y1 and subject_bb.y1 >= object_bb.y1)
             {
                 ARMARX_VERBOSE << "Found SSR: " << subject.class_name << " surrounds " << object.class_name;
-                ssr_matrix.at(subject_index).at(object_index).static_surround(true);
+                ssr_matrix(subject_index, object_index).static_surround(true);
                 // =>
-                ssr_matrix.at(object_index).at(subject_index).static_inside(true);
+                ssr_matrix(object_index, subject_index).static_inside(true);
             }
         }
     }
@@ -281,7 +580,7 @@ ssr::evaluate_static_relations(
 void
 ssr::evaluate_dynamic_relations(
     const std::vector<detected_object>& objects,
-    std::vector<std::vector<relations>>& ssr_matrix,
+    ssr::ssr_matrix& ssr_matrix,
     const double distance_equality_threshold)
 {
     const unsigned long dim = objects.size();
@@ -342,20 +641,20 @@ ssr::evaluate_dynamic_relations(
                 // If both objects moved
                 if (p3 and p4)
                 {
-                    ssr_matrix.at(i).at(j).dynamic_moving_together(true);
-                    ssr_matrix.at(j).at(i).dynamic_moving_together(true);
+                    ssr_matrix(i, j).dynamic_moving_together(true);
+                    ssr_matrix(j, i).dynamic_moving_together(true);
                 }
                 // If no object moved
                 else if (!p3 and !p4)
                 {
-                    ssr_matrix.at(i).at(j).dynamic_halting_together(true);
-                    ssr_matrix.at(j).at(i).dynamic_halting_together(true);
+                    ssr_matrix(i, j).dynamic_halting_together(true);
+                    ssr_matrix(j, i).dynamic_halting_together(true);
                 }
                 // If exactly one object moved
                 else if (p3 xor p4)
                 {
-                    ssr_matrix.at(i).at(j).dynamic_fixed_moving_together(true);
-                    ssr_matrix.at(j).at(i).dynamic_fixed_moving_together(true);
+                    ssr_matrix(i, j).dynamic_fixed_moving_together(true);
+                    ssr_matrix(j, i).dynamic_fixed_moving_together(true);
                 }
             }
             // If objects were not in contact and were not in contact earlier
@@ -365,23 +664,53 @@ ssr::evaluate_dynamic_relations(
                 // equality threshold (zeta), which is not in the paper, but doesn't make sense otherwise
                 if (delta_ab - delta_ab_past < -distance_equality_threshold)
                 {
-                    ssr_matrix.at(i).at(j).dynamic_getting_close(true);
-                    ssr_matrix.at(j).at(i).dynamic_getting_close(true);
+                    ssr_matrix(i, j).dynamic_getting_close(true);
+                    ssr_matrix(j, i).dynamic_getting_close(true);
                 }
                 // If the distance now is (considerably) greater than previously
                 else if (delta_ab - delta_ab_past > distance_equality_threshold)
                 {
-                    ssr_matrix.at(i).at(j).dynamic_moving_apart(true);
-                    ssr_matrix.at(j).at(i).dynamic_moving_apart(true);
+                    ssr_matrix(i, j).dynamic_moving_apart(true);
+                    ssr_matrix(j, i).dynamic_moving_apart(true);
                 }
                 // This case is basically: | delta_ab - delta_ab_past | < zeta
                 // In words: The distance between the objects now and then has not considerably changed
                 else
                 {
-                    ssr_matrix.at(i).at(j).dynamic_stable(true);
-                    ssr_matrix.at(j).at(i).dynamic_stable(true);
+                    ssr_matrix(i, j).dynamic_stable(true);
+                    ssr_matrix(j, i).dynamic_stable(true);
                 }
             }
         }
     }
 }
+
+
+void
+ssr::evaluate_dynamic_relations_fused(
+    const std::vector<detected_object>& objects,
+    ssr::ssr_matrix& ssr_matrix,
+    const double distance_equality_threshold)
+{
+    ARMARX_CHECK_EQUAL_W_HINT(objects.size(), ssr_matrix.dim(), "SSR matrix does not match the objects");
+
+    const std::size_t dim = objects.size();
+
+    std::vector<kernel::object_summary<float>> summaries;
+    summaries.reserve(dim);
+    for (const detected_object& object : objects)
+        summaries.push_back(kernel::summarise(::box_of(object.bounding_box), ::box_of(object.past_bounding_box),
+                                              distance_equality_threshold));
+
+    for (std::size_t subject_index = 0; subject_index < dim; ++subject_index)
+    {
+        const kernel::object_summary<float>& subject = summaries[subject_index];
+        for (std::size_t object_index = subject_index + 1; object_index < dim; ++object_index)
+        {
+            const kernel::object_summary<float>& object = summaries[object_index];
+            kernel::evaluate_dynamic_pair(subject, object, kernel::is_colliding(subject.bb, object.bb),
+                                          distance_equality_threshold, ssr_matrix(subject_index, object_index),
+                                          ssr_matrix(object_index, subject_index));
+        }
+    }
+}
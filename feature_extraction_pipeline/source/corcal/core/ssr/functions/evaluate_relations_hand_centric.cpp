@@ -0,0 +1,138 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/functions.h>
+
+
+// STD/STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    /**
+     * @brief Euclidean distance between two bounding boxes, 0 if they overlap
+     */
+    float
+    distance_between(const visionx::BoundingBox3D& a, const visionx::BoundingBox3D& b)
+    {
+        const float dx = std::max({0.f, a.x0 - b.x1, b.x0 - a.x1});
+        const float dy = std::max({0.f, a.y0 - b.y1, b.y0 - a.y1});
+        const float dz = std::max({0.f, a.z0 - b.z1, b.z0 - a.z1});
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+
+ssr_sparse_cell_list
+ssr::evaluate_relations_hand_centric(
+    const std::vector<detected_object>& objects,
+    const double distance_equality_threshold,
+    const hand_centric_options& options)
+{
+    const std::size_t count = objects.size();
+
+    std::vector<std::size_t> hands;
+    std::vector<bool> is_hand(count, false);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (std::find(options.hand_class_names.begin(), options.hand_class_names.end(), objects[i].class_name)
+            != options.hand_class_names.end())
+        {
+            hands.push_back(i);
+            is_hand[i] = true;
+        }
+    }
+
+    // Objects in the neighbourhood of any hand
+    std::vector<bool> is_neighbour(count, false);
+    std::vector<std::pair<float, std::size_t>> distances;
+    for (const std::size_t hand : hands)
+    {
+        distances.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (is_hand[i]) continue;
+
+            const float distance = ::distance_between(objects[hand].bounding_box, objects[i].bounding_box);
+            if (distance <= options.neighbourhood_distance)
+                is_neighbour[i] = true;
+            distances.emplace_back(distance, i);
+        }
+
+        const std::size_t nearest = std::min(options.nearest_neighbours, distances.size());
+        std::nth_element(distances.begin(), distances.begin() + nearest, distances.end());
+        for (std::size_t k = 0; k < nearest; ++k)
+            is_neighbour[distances[k].second] = true;
+    }
+
+    std::vector<std::size_t> neighbours;
+    for (std::size_t i = 0; i < count; ++i)
+        if (is_neighbour[i])
+            neighbours.push_back(i);
+
+    // Each pair once, with the lower index as subject so that the cells equal those of evaluate_relations
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for (const std::size_t hand : hands)
+        for (std::size_t i = 0; i < count; ++i)
+            if (i != hand and not (is_hand[i] and i < hand))
+                pairs.emplace_back(std::min(hand, i), std::max(hand, i));
+    for (std::size_t a = 0; a < neighbours.size(); ++a)
+        for (std::size_t b = a + 1; b < neighbours.size(); ++b)
+            pairs.emplace_back(neighbours[a], neighbours[b]);
+
+    ssr_sparse_cell_list cells;
+    for (const auto& [subject, object] : pairs)
+    {
+        relations subject_to_object;
+        relations object_to_subject;
+        evaluate_pair(
+            objects[subject].bounding_box,
+            objects[subject].past_bounding_box,
+            objects[object].bounding_box,
+            objects[object].past_bounding_box,
+            distance_equality_threshold,
+            subject_to_object,
+            object_to_subject
+        );
+
+        if (subject_to_object.mask() != 0)
+            cells.push_back({static_cast<int>(subject), static_cast<int>(object), subject_to_object.mask()});
+        if (object_to_subject.mask() != 0)
+            cells.push_back({static_cast<int>(object), static_cast<int>(subject), object_to_subject.mask()});
+    }
+
+    std::sort(cells.begin(), cells.end(), [](const ssr_sparse_cell& a, const ssr_sparse_cell& b)
+    {
+        return std::make_pair(a.subject_index, a.object_index) < std::make_pair(b.subject_index, b.object_index);
+    });
+
+    return cells;
+}
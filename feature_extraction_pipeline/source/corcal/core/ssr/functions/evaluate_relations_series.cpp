@@ -0,0 +1,129 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#include <corcal/core/ssr/functions.h>
+
+
+// STD/STL
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// corcal
+#include <corcal/core/ssr.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    /**
+     * @brief Calls evaluate_frame(frame) for all frames on thread_count worker threads
+     *
+     * Frames are handed out one by one, so that frames with many objects do not stall a whole chunk.  The first
+     * exception thrown by any worker is rethrown after all workers finished.
+     */
+    template <typename evaluate_frame_fn>
+    void
+    for_each_frame_parallel(std::size_t frame_count, unsigned int thread_count, evaluate_frame_fn evaluate_frame)
+    {
+        if (thread_count == 0)
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        thread_count = static_cast<unsigned int>(std::min<std::size_t>(thread_count, frame_count));
+
+        std::atomic<std::size_t> next_frame{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        const auto worker = [&]()
+        {
+            try
+            {
+                for (std::size_t frame = next_frame++; frame < frame_count; frame = next_frame++)
+                    evaluate_frame(frame);
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> lock{error_mutex};
+                if (not error)
+                    error = std::current_exception();
+
+                // Let the other workers run out
+                next_frame = frame_count;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count);
+        for (unsigned int i = 0; i < thread_count; ++i)
+            workers.emplace_back(worker);
+        for (std::thread& thread : workers)
+            thread.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+
+std::vector<ssr::ssr_matrix>
+ssr::evaluate_relations_series(
+    const ssr::object_series& series,
+    const double distance_equality_threshold,
+    const unsigned int thread_count)
+{
+    std::vector<ssr::ssr_matrix> ssr_matrices(series.frame_count());
+
+    ::for_each_frame_parallel(series.frame_count(), thread_count, [&](std::size_t frame)
+    {
+        ssr_matrices[frame] = ssr::evaluate_relations_fused(series.bounding_boxes(frame),
+                                                            series.past_bounding_boxes(frame),
+                                                            series.object_count(frame),
+                                                            distance_equality_threshold);
+    });
+
+    return ssr_matrices;
+}
+
+
+std::vector<ssr::ssr_matrix>
+ssr::evaluate_relations_series(
+    const std::vector<std::vector<detected_object>>& frames,
+    const double distance_equality_threshold,
+    const unsigned int thread_count)
+{
+    std::vector<ssr::ssr_matrix> ssr_matrices(frames.size());
+
+    ::for_each_frame_parallel(frames.size(), thread_count, [&](std::size_t frame)
+    {
+        ssr_matrices[frame] = ssr::evaluate_relations(frames[frame], distance_equality_threshold);
+    });
+
+    return ssr_matrices;
+}
@@ -0,0 +1,490 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/functions.h>
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+// SIMD intrinsics
+#if defined(__x86_64__) or defined(__i386__)
+#define CORCAL_SSR_X86
+#include <immintrin.h>
+#endif
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+// corcal
+#include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+using namespace corcal::core;
+using namespace corcal::core::ssr;
+
+
+namespace
+{
+    /**
+     * @brief Number of padding lanes appended to the SoA arrays, so that a batch of the widest instruction set may
+     *        always be loaded without bounds checks
+     */
+    const std::size_t lane_padding = 16;
+
+
+    /**
+     * @brief Structure-of-arrays copy of the current bounding boxes
+     *
+     * The arrays are padded with NaNs.  Since every ordered comparison with NaN is false, padding lanes never yield a
+     * relation.
+     */
+    struct box_soa
+    {
+        std::vector<float> x0;
+        std::vector<float> y0;
+        std::vector<float> z0;
+        std::vector<float> x1;
+        std::vector<float> y1;
+        std::vector<float> z1;
+
+        explicit box_soa(const std::vector<detected_object>& objects)
+        {
+            const std::size_t padded_size = objects.size() + lane_padding;
+            const float nan = std::numeric_limits<float>::quiet_NaN();
+            for (std::vector<float>* v : {&x0, &y0, &z0, &x1, &y1, &z1})
+                v->assign(padded_size, nan);
+
+            for (std::size_t i = 0; i < objects.size(); ++i)
+            {
+                const visionx::BoundingBox3D& bb = objects[i].bounding_box;
+                x0[i] = bb.x0;
+                y0[i] = bb.y0;
+                z0[i] = bb.z0;
+                x1[i] = bb.x1;
+                y1[i] = bb.y1;
+                z1[i] = bb.z1;
+            }
+        }
+    };
+
+
+    /**
+     * @brief Bit masks of the relations evaluated by the batched kernels
+     */
+    struct static_masks
+    {
+        std::uint16_t contact;
+        std::uint16_t left_of;
+        std::uint16_t right_of;
+        std::uint16_t below;
+        std::uint16_t above;
+        std::uint16_t behind_of;
+        std::uint16_t in_front_of;
+        std::uint16_t inside;
+        std::uint16_t surround;
+    };
+
+
+    constexpr static_masks static_relation_masks{
+        mask_of(relation::contact),
+        mask_of(relation::static_left_of),
+        mask_of(relation::static_right_of),
+        mask_of(relation::static_below),
+        mask_of(relation::static_above),
+        mask_of(relation::static_behind_of),
+        mask_of(relation::static_in_front_of),
+        mask_of(relation::static_inside),
+        mask_of(relation::static_surround)
+    };
+
+
+    const static_masks&
+    masks()
+    {
+        return static_relation_masks;
+    }
+
+
+    /**
+     * @brief Signature of a batched kernel
+     *
+     * Evaluates the subject box against `count` object boxes starting at index `begin`.  For each lane k, out[k]
+     * receives the relations subject→object and out_inverse[k] the relations object→subject.  Both output arrays
+     * must have room for `count` rounded up to the kernel's batch width.
+     */
+    using batch_kernel = void (*)(
+        const box_soa& boxes,
+        std::size_t subject,
+        std::size_t begin,
+        std::size_t count,
+        const static_masks& m,
+        std::uint16_t* out,
+        std::uint16_t* out_inverse
+    );
+
+
+    /**
+     * @brief Portable reference kernel, one object box at a time
+     *
+     * The predicates mirror evaluate_contact_relations and evaluate_static_relations, where the else-branches are
+     * expressed as "and not" of the preceding condition.
+     */
+    void
+    kernel_scalar(const box_soa& b, std::size_t s, std::size_t begin, std::size_t count, const static_masks& m,
+                  std::uint16_t* out, std::uint16_t* out_inverse)
+    {
+        const float sx0 = b.x0[s], sy0 = b.y0[s], sz0 = b.z0[s];
+        const float sx1 = b.x1[s], sy1 = b.y1[s], sz1 = b.z1[s];
+
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const std::size_t o = begin + k;
+            const float ox0 = b.x0[o], oy0 = b.y0[o], oz0 = b.z0[o];
+            const float ox1 = b.x1[o], oy1 = b.y1[o], oz1 = b.z1[o];
+
+            const bool contact = sx0 <= ox1 and sx1 >= ox0 and sy0 <= oy1 and sy1 >= oy0 and sz0 <= oz1
+                and sz1 >= oz0;
+            const bool left_of = sx1 < ox0;
+            const bool right_of = not left_of and sx0 > ox1;
+            const bool below = sy1 < oy0;
+            const bool above = not below and sy0 > oy1;
+            const bool behind_of = sz1 < oz0;
+            const bool in_front_of = not behind_of and sz0 > oz1;
+            const bool inside = ox0 < sx0 and sx1 < ox1 and oz0 < sz0 and sz1 < oz1 and oy0 < sy0 and sy0 <= oy1;
+            const bool surround = not inside and ox0 > sx0 and sx1 > ox1 and oz0 > sz0 and sz1 > oz1
+                and oy0 > sy1 and sy1 >= oy1;
+
+            out[k] = static_cast<std::uint16_t>(
+                (contact ? m.contact : 0) | (left_of ? m.left_of : 0) | (right_of ? m.right_of : 0)
+                | (below ? m.below : 0) | (above ? m.above : 0) | (behind_of ? m.behind_of : 0)
+                | (in_front_of ? m.in_front_of : 0) | (inside ? m.inside : 0) | (surround ? m.surround : 0));
+            out_inverse[k] = static_cast<std::uint16_t>(
+                (contact ? m.contact : 0) | (left_of ? m.right_of : 0) | (right_of ? m.left_of : 0)
+                | (below ? m.above : 0) | (above ? m.below : 0) | (behind_of ? m.in_front_of : 0)
+                | (in_front_of ? m.behind_of : 0) | (inside ? m.surround : 0) | (surround ? m.inside : 0));
+        }
+    }
+
+
+#ifdef CORCAL_SSR_X86
+    /**
+     * @brief SSE2 kernel, 4 object boxes per batch
+     */
+    __attribute__((target("sse2")))
+    void
+    kernel_sse2(const box_soa& b, std::size_t s, std::size_t begin, std::size_t count, const static_masks& m,
+                std::uint16_t* out, std::uint16_t* out_inverse)
+    {
+        const __m128 sx0 = _mm_set1_ps(b.x0[s]), sy0 = _mm_set1_ps(b.y0[s]), sz0 = _mm_set1_ps(b.z0[s]);
+        const __m128 sx1 = _mm_set1_ps(b.x1[s]), sy1 = _mm_set1_ps(b.y1[s]), sz1 = _mm_set1_ps(b.z1[s]);
+
+        for (std::size_t k = 0; k < count; k += 4)
+        {
+            const std::size_t o = begin + k;
+            const __m128 ox0 = _mm_loadu_ps(&b.x0[o]), oy0 = _mm_loadu_ps(&b.y0[o]), oz0 = _mm_loadu_ps(&b.z0[o]);
+            const __m128 ox1 = _mm_loadu_ps(&b.x1[o]), oy1 = _mm_loadu_ps(&b.y1[o]), oz1 = _mm_loadu_ps(&b.z1[o]);
+
+            const __m128 contact = _mm_and_ps(
+                _mm_and_ps(_mm_and_ps(_mm_cmple_ps(sx0, ox1), _mm_cmpge_ps(sx1, ox0)),
+                           _mm_and_ps(_mm_cmple_ps(sy0, oy1), _mm_cmpge_ps(sy1, oy0))),
+                _mm_and_ps(_mm_cmple_ps(sz0, oz1), _mm_cmpge_ps(sz1, oz0)));
+            const __m128 left_of = _mm_cmplt_ps(sx1, ox0);
+            const __m128 right_of = _mm_andnot_ps(left_of, _mm_cmpgt_ps(sx0, ox1));
+            const __m128 below = _mm_cmplt_ps(sy1, oy0);
+            const __m128 above = _mm_andnot_ps(below, _mm_cmpgt_ps(sy0, oy1));
+            const __m128 behind_of = _mm_cmplt_ps(sz1, oz0);
+            const __m128 in_front_of = _mm_andnot_ps(behind_of, _mm_cmpgt_ps(sz0, oz1));
+            const __m128 inside = _mm_and_ps(
+                _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(ox0, sx0), _mm_cmplt_ps(sx1, ox1)),
+                           _mm_and_ps(_mm_cmplt_ps(oz0, sz0), _mm_cmplt_ps(sz1, oz1))),
+                _mm_and_ps(_mm_cmplt_ps(oy0, sy0), _mm_cmple_ps(sy0, oy1)));
+            const __m128 surround = _mm_andnot_ps(inside, _mm_and_ps(
+                _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(ox0, sx0), _mm_cmpgt_ps(sx1, ox1)),
+                           _mm_and_ps(_mm_cmpgt_ps(oz0, sz0), _mm_cmpgt_ps(sz1, oz1))),
+                _mm_and_ps(_mm_cmpgt_ps(oy0, sy1), _mm_cmpge_ps(sy1, oy1))));
+
+            const __m128 predicates[] = {contact, left_of, right_of, below, above, behind_of, in_front_of, inside,
+                                         surround};
+            const std::uint16_t bits[] = {m.contact, m.left_of, m.right_of, m.below, m.above, m.behind_of,
+                                          m.in_front_of, m.inside, m.surround};
+            const std::uint16_t inverse_bits[] = {m.contact, m.right_of, m.left_of, m.above, m.below, m.in_front_of,
+                                                  m.behind_of, m.surround, m.inside};
+
+            __m128i mask = _mm_setzero_si128();
+            __m128i mask_inverse = _mm_setzero_si128();
+            for (unsigned int p = 0; p < 9; ++p)
+            {
+                const __m128i predicate = _mm_castps_si128(predicates[p]);
+                mask = _mm_or_si128(mask, _mm_and_si128(predicate, _mm_set1_epi32(bits[p])));
+                mask_inverse = _mm_or_si128(mask_inverse, _mm_and_si128(predicate, _mm_set1_epi32(inverse_bits[p])));
+            }
+
+            // Masks of the static relations fit into 15 bits, so signed saturation is lossless
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + k), _mm_packs_epi32(mask, mask));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out_inverse + k), _mm_packs_epi32(mask_inverse, mask_inverse));
+        }
+    }
+
+
+    /**
+     * @brief AVX2 kernel, 8 object boxes per batch
+     */
+    __attribute__((target("avx2")))
+    void
+    kernel_avx2(const box_soa& b, std::size_t s, std::size_t begin, std::size_t count, const static_masks& m,
+                std::uint16_t* out, std::uint16_t* out_inverse)
+    {
+        const __m256 sx0 = _mm256_set1_ps(b.x0[s]), sy0 = _mm256_set1_ps(b.y0[s]), sz0 = _mm256_set1_ps(b.z0[s]);
+        const __m256 sx1 = _mm256_set1_ps(b.x1[s]), sy1 = _mm256_set1_ps(b.y1[s]), sz1 = _mm256_set1_ps(b.z1[s]);
+
+        for (std::size_t k = 0; k < count; k += 8)
+        {
+            const std::size_t o = begin + k;
+            const __m256 ox0 = _mm256_loadu_ps(&b.x0[o]), oy0 = _mm256_loadu_ps(&b.y0[o]);
+            const __m256 oz0 = _mm256_loadu_ps(&b.z0[o]), ox1 = _mm256_loadu_ps(&b.x1[o]);
+            const __m256 oy1 = _mm256_loadu_ps(&b.y1[o]), oz1 = _mm256_loadu_ps(&b.z1[o]);
+
+            const __m256 contact = _mm256_and_ps(
+                _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(sx0, ox1, _CMP_LE_OQ), _mm256_cmp_ps(sx1, ox0, _CMP_GE_OQ)),
+                              _mm256_and_ps(_mm256_cmp_ps(sy0, oy1, _CMP_LE_OQ), _mm256_cmp_ps(sy1, oy0, _CMP_GE_OQ))),
+                _mm256_and_ps(_mm256_cmp_ps(sz0, oz1, _CMP_LE_OQ), _mm256_cmp_ps(sz1, oz0, _CMP_GE_OQ)));
+            const __m256 left_of = _mm256_cmp_ps(sx1, ox0, _CMP_LT_OQ);
+            const __m256 right_of = _mm256_andnot_ps(left_of, _mm256_cmp_ps(sx0, ox1, _CMP_GT_OQ));
+            const __m256 below = _mm256_cmp_ps(sy1, oy0, _CMP_LT_OQ);
+            const __m256 above = _mm256_andnot_ps(below, _mm256_cmp_ps(sy0, oy1, _CMP_GT_OQ));
+            const __m256 behind_of = _mm256_cmp_ps(sz1, oz0, _CMP_LT_OQ);
+            const __m256 in_front_of = _mm256_andnot_ps(behind_of, _mm256_cmp_ps(sz0, oz1, _CMP_GT_OQ));
+            const __m256 inside = _mm256_and_ps(
+                _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(ox0, sx0, _CMP_LT_OQ), _mm256_cmp_ps(sx1, ox1, _CMP_LT_OQ)),
+                              _mm256_and_ps(_mm256_cmp_ps(oz0, sz0, _CMP_LT_OQ), _mm256_cmp_ps(sz1, oz1, _CMP_LT_OQ))),
+                _mm256_and_ps(_mm256_cmp_ps(oy0, sy0, _CMP_LT_OQ), _mm256_cmp_ps(sy0, oy1, _CMP_LE_OQ)));
+            const __m256 surround = _mm256_andnot_ps(inside, _mm256_and_ps(
+                _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(ox0, sx0, _CMP_GT_OQ), _mm256_cmp_ps(sx1, ox1, _CMP_GT_OQ)),
+                              _mm256_and_ps(_mm256_cmp_ps(oz0, sz0, _CMP_GT_OQ), _mm256_cmp_ps(sz1, oz1, _CMP_GT_OQ))),
+                _mm256_and_ps(_mm256_cmp_ps(oy0, sy1, _CMP_GT_OQ), _mm256_cmp_ps(sy1, oy1, _CMP_GE_OQ))));
+
+            const __m256 predicates[] = {contact, left_of, right_of, below, above, behind_of, in_front_of, inside,
+                                         surround};
+            const std::uint16_t bits[] = {m.contact, m.left_of, m.right_of, m.below, m.above, m.behind_of,
+                                          m.in_front_of, m.inside, m.surround};
+            const std::uint16_t inverse_bits[] = {m.contact, m.right_of, m.left_of, m.above, m.below, m.in_front_of,
+                                                  m.behind_of, m.surround, m.inside};
+
+            __m256i mask = _mm256_setzero_si256();
+            __m256i mask_inverse = _mm256_setzero_si256();
+            for (unsigned int p = 0; p < 9; ++p)
+            {
+                const __m256i predicate = _mm256_castps_si256(predicates[p]);
+                mask = _mm256_or_si256(mask, _mm256_and_si256(predicate, _mm256_set1_epi32(bits[p])));
+                mask_inverse = _mm256_or_si256(mask_inverse,
+                                               _mm256_and_si256(predicate, _mm256_set1_epi32(inverse_bits[p])));
+            }
+
+            // Narrow 8×32 bit to 8×16 bit, keeping the lane order
+            const __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(mask), _mm256_extracti128_si256(mask, 1));
+            const __m128i packed_inverse = _mm_packus_epi32(_mm256_castsi256_si128(mask_inverse),
+                                                            _mm256_extracti128_si256(mask_inverse, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), packed);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out_inverse + k), packed_inverse);
+        }
+    }
+
+
+    /**
+     * @brief AVX-512 kernel, 16 object boxes per batch
+     */
+    __attribute__((target("avx512f")))
+    void
+    kernel_avx512(const box_soa& b, std::size_t s, std::size_t begin, std::size_t count, const static_masks& m,
+                  std::uint16_t* out, std::uint16_t* out_inverse)
+    {
+        const __m512 sx0 = _mm512_set1_ps(b.x0[s]), sy0 = _mm512_set1_ps(b.y0[s]), sz0 = _mm512_set1_ps(b.z0[s]);
+        const __m512 sx1 = _mm512_set1_ps(b.x1[s]), sy1 = _mm512_set1_ps(b.y1[s]), sz1 = _mm512_set1_ps(b.z1[s]);
+
+        for (std::size_t k = 0; k < count; k += 16)
+        {
+            const std::size_t o = begin + k;
+            const __m512 ox0 = _mm512_loadu_ps(&b.x0[o]), oy0 = _mm512_loadu_ps(&b.y0[o]);
+            const __m512 oz0 = _mm512_loadu_ps(&b.z0[o]), ox1 = _mm512_loadu_ps(&b.x1[o]);
+            const __m512 oy1 = _mm512_loadu_ps(&b.y1[o]), oz1 = _mm512_loadu_ps(&b.z1[o]);
+
+            // Comparisons directly yield one bit per lane
+            const __mmask16 contact
+                = _mm512_cmp_ps_mask(sx0, ox1, _CMP_LE_OQ) & _mm512_cmp_ps_mask(sx1, ox0, _CMP_GE_OQ)
+                & _mm512_cmp_ps_mask(sy0, oy1, _CMP_LE_OQ) & _mm512_cmp_ps_mask(sy1, oy0, _CMP_GE_OQ)
+                & _mm512_cmp_ps_mask(sz0, oz1, _CMP_LE_OQ) & _mm512_cmp_ps_mask(sz1, oz0, _CMP_GE_OQ);
+            const __mmask16 left_of = _mm512_cmp_ps_mask(sx1, ox0, _CMP_LT_OQ);
+            const __mmask16 right_of = ~left_of & _mm512_cmp_ps_mask(sx0, ox1, _CMP_GT_OQ);
+            const __mmask16 below = _mm512_cmp_ps_mask(sy1, oy0, _CMP_LT_OQ);
+            const __mmask16 above = ~below & _mm512_cmp_ps_mask(sy0, oy1, _CMP_GT_OQ);
+            const __mmask16 behind_of = _mm512_cmp_ps_mask(sz1, oz0, _CMP_LT_OQ);
+            const __mmask16 in_front_of = ~behind_of & _mm512_cmp_ps_mask(sz0, oz1, _CMP_GT_OQ);
+            const __mmask16 inside = _mm512_cmp_ps_mask(ox0, sx0, _CMP_LT_OQ) & _mm512_cmp_ps_mask(sx1, ox1, _CMP_LT_OQ)
+                & _mm512_cmp_ps_mask(oz0, sz0, _CMP_LT_OQ) & _mm512_cmp_ps_mask(sz1, oz1, _CMP_LT_OQ)
+                & _mm512_cmp_ps_mask(oy0, sy0, _CMP_LT_OQ) & _mm512_cmp_ps_mask(sy0, oy1, _CMP_LE_OQ);
+            const __mmask16 surround = ~inside & _mm512_cmp_ps_mask(ox0, sx0, _CMP_GT_OQ)
+                & _mm512_cmp_ps_mask(sx1, ox1, _CMP_GT_OQ) & _mm512_cmp_ps_mask(oz0, sz0, _CMP_GT_OQ)
+                & _mm512_cmp_ps_mask(sz1, oz1, _CMP_GT_OQ) & _mm512_cmp_ps_mask(oy0, sy1, _CMP_GT_OQ)
+                & _mm512_cmp_ps_mask(sy1, oy1, _CMP_GE_OQ);
+
+            const __mmask16 predicates[] = {contact, left_of, right_of, below, above, behind_of, in_front_of, inside,
+                                            surround};
+            const std::uint16_t bits[] = {m.contact, m.left_of, m.right_of, m.below, m.above, m.behind_of,
+                                          m.in_front_of, m.inside, m.surround};
+            const std::uint16_t inverse_bits[] = {m.contact, m.right_of, m.left_of, m.above, m.below, m.in_front_of,
+                                                  m.behind_of, m.surround, m.inside};
+
+            __m512i mask = _mm512_setzero_si512();
+            __m512i mask_inverse = _mm512_setzero_si512();
+            for (unsigned int p = 0; p < 9; ++p)
+            {
+                mask = _mm512_mask_or_epi32(mask, predicates[p], mask, _mm512_set1_epi32(bits[p]));
+                mask_inverse = _mm512_mask_or_epi32(mask_inverse, predicates[p], mask_inverse,
+                                                    _mm512_set1_epi32(inverse_bits[p]));
+            }
+
+            _mm512_mask_cvtepi32_storeu_epi16(out + k, 0xFFFF, mask);
+            _mm512_mask_cvtepi32_storeu_epi16(out_inverse + k, 0xFFFF, mask_inverse);
+        }
+    }
+#endif
+
+
+    batch_kernel
+    select_kernel(instruction_set isa)
+    {
+        switch (isa)
+        {
+#ifdef CORCAL_SSR_X86
+            case instruction_set::avx512:
+                return &::kernel_avx512;
+            case instruction_set::avx2:
+                return &::kernel_avx2;
+            case instruction_set::sse2:
+                return &::kernel_sse2;
+#else
+            case instruction_set::avx512:
+            case instruction_set::avx2:
+            case instruction_set::sse2:
+#endif
+            case instruction_set::scalar:
+                return &::kernel_scalar;
+        }
+
+        return &::kernel_scalar;
+    }
+}
+
+
+ssr::instruction_set
+ssr::detect_instruction_set()
+{
+#ifdef CORCAL_SSR_X86
+    static const instruction_set detected = []
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return instruction_set::avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return instruction_set::avx2;
+        if (__builtin_cpu_supports("sse2"))
+            return instruction_set::sse2;
+        return instruction_set::scalar;
+    }();
+    return detected;
+#else
+    return instruction_set::scalar;
+#endif
+}
+
+
+bool
+ssr::is_supported(const instruction_set isa)
+{
+    return isa <= ssr::detect_instruction_set();
+}
+
+
+std::string
+ssr::to_string(const instruction_set isa)
+{
+    switch (isa)
+    {
+        case instruction_set::scalar:
+            return "scalar";
+        case instruction_set::sse2:
+            return "sse2";
+        case instruction_set::avx2:
+            return "avx2";
+        case instruction_set::avx512:
+            return "avx512";
+    }
+
+    return "unknown";
+}
+
+
+void
+ssr::evaluate_static_relations_batched(
+    const std::vector<detected_object>& objects,
+    ssr::ssr_matrix& ssr_matrix,
+    const instruction_set isa)
+{
+    ARMARX_CHECK_EXPRESSION_W_HINT(ssr::is_supported(isa), "Instruction set " + ssr::to_string(isa)
+        + " is not supported by this CPU");
+    ARMARX_CHECK_EQUAL(ssr_matrix.dim(), objects.size());
+
+    const std::size_t dim = objects.size();
+    const ::box_soa boxes{objects};
+    const ::static_masks& m = ::masks();
+    const ::batch_kernel kernel = ::select_kernel(isa);
+
+    // Room for one row plus a partial batch of the widest kernel
+    std::vector<std::uint16_t> row(dim + ::lane_padding);
+    std::vector<std::uint16_t> row_inverse(dim + ::lane_padding);
+
+    // Same iteration scheme as evaluate_static_relations, but each subject is tested against all objects with a
+    // greater index in batches
+    for (std::size_t subject_index = 0; subject_index + 1 < dim; ++subject_index)
+    {
+        const std::size_t begin = subject_index + 1;
+        const std::size_t count = dim - begin;
+        kernel(boxes, subject_index, begin, count, m, row.data(), row_inverse.data());
+
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const std::size_t object_index = begin + k;
+            relations& rel = ssr_matrix(subject_index, object_index);
+            relations& rel_inv = ssr_matrix(object_index, subject_index);
+            rel = rel.mask() | row[k];
+            rel_inv = rel_inv.mask() | row_inverse[k];
+        }
+    }
+}
@@ -0,0 +1,287 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/functions.h>
+
+
+// STD/STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+// VisionX
+#include <VisionX/interface/core/DataTypes.h>
+
+// corcal
+#include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+using namespace corcal::core;
+using namespace corcal::core::ssr;
+using bounding_box = visionx::BoundingBox3D;
+
+
+namespace
+{
+    /**
+     * @brief Lower and upper bound of a bounding box along one axis
+     */
+    struct interval
+    {
+        float lo;
+        float hi;
+    };
+
+
+    interval
+    along(const bounding_box& bb, unsigned int axis)
+    {
+        switch (axis)
+        {
+            case 0: return interval{bb.x0, bb.x1};
+            case 1: return interval{bb.y0, bb.y1};
+            default: return interval{bb.z0, bb.z1};
+        }
+    }
+
+
+    /**
+     * @brief A box is considered valid if its bounds are ordered along every axis, which also rules out NaNs
+     */
+    bool
+    is_valid(const bounding_box& bb)
+    {
+        return bb.x0 <= bb.x1 and bb.y0 <= bb.y1 and bb.z0 <= bb.z1;
+    }
+
+
+    /**
+     * @brief Picks the axis along which the box centres are spread the most, so that the sweep sees as few
+     *        overlapping intervals as possible
+     */
+    unsigned int
+    select_sweep_axis(const std::vector<bounding_box>& boxes)
+    {
+        std::array<double, 3> sum{0, 0, 0};
+        std::array<double, 3> sum_sq{0, 0, 0};
+        for (const bounding_box& bb : boxes)
+        {
+            for (unsigned int axis = 0; axis < 3; ++axis)
+            {
+                const interval iv = ::along(bb, axis);
+                const double centre = (static_cast<double>(iv.lo) + iv.hi) / 2;
+                sum[axis] += centre;
+                sum_sq[axis] += centre * centre;
+            }
+        }
+
+        unsigned int best_axis = 0;
+        double best_variance = -1;
+        for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+            const double n = static_cast<double>(boxes.size());
+            const double variance = sum_sq[axis] / n - (sum[axis] / n) * (sum[axis] / n);
+            if (variance > best_variance)
+            {
+                best_variance = variance;
+                best_axis = axis;
+            }
+        }
+
+        return best_axis;
+    }
+
+
+    /**
+     * @brief For each pair (a, b) where a lies strictly before b along the given axis (a.hi < b.lo), calls
+     *        set(a, b)
+     *
+     * Instead of comparing every pair, the lower bounds are sorted once and the objects strictly after a are found by
+     * binary search on a.hi, so only the resulting pairs are visited.
+     */
+    template <typename Setter>
+    void
+    for_each_strictly_before(const std::vector<bounding_box>& boxes, unsigned int axis, Setter set)
+    {
+        const std::size_t dim = boxes.size();
+
+        std::vector<std::pair<float, std::size_t>> sorted_lo(dim);
+        for (std::size_t i = 0; i < dim; ++i)
+            sorted_lo[i] = {::along(boxes[i], axis).lo, i};
+        std::sort(sorted_lo.begin(), sorted_lo.end());
+
+        for (std::size_t a = 0; a < dim; ++a)
+        {
+            const float a_hi = ::along(boxes[a], axis).hi;
+            auto first = std::upper_bound(sorted_lo.begin(), sorted_lo.end(), a_hi,
+                [](float value, const std::pair<float, std::size_t>& entry) -> bool
+                {
+                    return value < entry.first;
+                }
+            );
+
+            for (auto it = first; it != sorted_lo.end(); ++it)
+                set(a, it->second);
+        }
+    }
+}
+
+
+std::vector<std::pair<std::size_t, std::size_t>>
+ssr::find_overlapping_pairs(const std::vector<visionx::BoundingBox3D>& boxes)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    const std::size_t dim = boxes.size();
+    if (dim < 2) return pairs;
+
+    for (const bounding_box& bb : boxes)
+        ARMARX_CHECK_EXPRESSION_W_HINT(::is_valid(bb), "Sweep and prune requires ordered, non-NaN bounding boxes");
+
+    const unsigned int sweep_axis = ::select_sweep_axis(boxes);
+    const unsigned int other_axis_1 = (sweep_axis + 1) % 3;
+    const unsigned int other_axis_2 = (sweep_axis + 2) % 3;
+
+    // Sort by lower bound along the sweep axis
+    std::vector<std::size_t> order(dim);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [&](std::size_t a, std::size_t b) -> bool
+        {
+            return ::along(boxes[a], sweep_axis).lo < ::along(boxes[b], sweep_axis).lo;
+        }
+    );
+
+    // Sweep: Every box in the active list started before the current one, so it overlaps the current box along the
+    // sweep axis unless it already ended.  Boxes that ended before the current one started cannot overlap any later
+    // box either and are pruned
+    std::vector<std::size_t> active;
+    for (const std::size_t current : order)
+    {
+        const interval current_sweep = ::along(boxes[current], sweep_axis);
+        const interval current_1 = ::along(boxes[current], other_axis_1);
+        const interval current_2 = ::along(boxes[current], other_axis_2);
+
+        active.erase(
+            std::remove_if(active.begin(), active.end(),
+                [&](std::size_t candidate) -> bool
+                {
+                    return ::along(boxes[candidate], sweep_axis).hi < current_sweep.lo;
+                }
+            ),
+            active.end()
+        );
+
+        for (const std::size_t candidate : active)
+        {
+            const interval candidate_1 = ::along(boxes[candidate], other_axis_1);
+            const interval candidate_2 = ::along(boxes[candidate], other_axis_2);
+
+            // Same closed-interval test as is_colliding
+            if (candidate_1.lo <= current_1.hi and candidate_1.hi >= current_1.lo
+                and candidate_2.lo <= current_2.hi and candidate_2.hi >= current_2.lo)
+            {
+                pairs.emplace_back(std::min(candidate, current), std::max(candidate, current));
+            }
+        }
+
+        active.push_back(current);
+    }
+
+    return pairs;
+}
+
+
+void
+ssr::evaluate_static_relations_sweep(
+    const std::vector<detected_object>& objects,
+    ssr::ssr_matrix& ssr_matrix)
+{
+    ARMARX_CHECK_EQUAL(ssr_matrix.dim(), objects.size());
+
+    std::vector<bounding_box> boxes;
+    boxes.reserve(objects.size());
+    for (const detected_object& object : objects)
+        boxes.push_back(object.bounding_box);
+
+    // The broad phase and the rank order arguments below only hold for valid boxes, so fall back to the exhaustive
+    // passes otherwise
+    if (not std::all_of(boxes.begin(), boxes.end(), ::is_valid))
+    {
+        ssr::evaluate_contact_relations(objects, ssr_matrix);
+        ssr::evaluate_static_relations(objects, ssr_matrix);
+        return;
+    }
+
+    // Directional relations.  With valid boxes, at most one of "a before b" and "b before a" holds, and the
+    // relations of a pair do not depend on which of both is the subject of the iteration in
+    // evaluate_static_relations, so they can be read off the rank order along each axis
+    ::for_each_strictly_before(boxes, 0, [&](std::size_t a, std::size_t b)
+    {
+        ssr_matrix(a, b).static_left_of(true);
+        ssr_matrix(b, a).static_right_of(true);
+    });
+    ::for_each_strictly_before(boxes, 1, [&](std::size_t a, std::size_t b)
+    {
+        ssr_matrix(a, b).static_below(true);
+        ssr_matrix(b, a).static_above(true);
+    });
+    ::for_each_strictly_before(boxes, 2, [&](std::size_t a, std::size_t b)
+    {
+        ssr_matrix(a, b).static_behind_of(true);
+        ssr_matrix(b, a).static_in_front_of(true);
+    });
+
+    // Contact, inside and surround imply overlap along every axis, so only the pairs of the broad phase need to be
+    // tested.  The narrow phase keeps the exact predicates (and subject/object order) of evaluate_static_relations
+    for (const std::pair<std::size_t, std::size_t>& pair : ssr::find_overlapping_pairs(boxes))
+    {
+        const std::size_t subject_index = pair.first;
+        const std::size_t object_index = pair.second;
+        const bounding_box& subject_bb = boxes[subject_index];
+        const bounding_box& object_bb = boxes[object_index];
+
+        ssr_matrix(subject_index, object_index).contact(true);
+        ssr_matrix(object_index, subject_index).contact(true);
+
+        if (object_bb.x0 < subject_bb.x0 and subject_bb.x1 < object_bb.x1 and object_bb.z0 < subject_bb.z0
+            and subject_bb.z1 < object_bb.z1 and object_bb.y0 < subject_bb.y0 and subject_bb.y0 <= object_bb.y1)
+        {
+            ssr_matrix(subject_index, object_index).static_inside(true);
+            ssr_matrix(object_index, subject_index).static_surround(true);
+        }
+        else if (object_bb.x0 > subject_bb.x0 and subject_bb.x1 > object_bb.x1 and object_bb.z0 > subject_bb.z0
+            and subject_bb.z1 > object_bb.z1 and object_bb.y0 > subject_bb.y1 and subject_bb.y1 >= object_bb.y1)
+        {
+            ssr_matrix(subject_index, object_index).static_surround(true);
+            ssr_matrix(object_index, subject_index).static_inside(true);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/functions.h>
+
+
+// STD/STL
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace corcal::core;
+
+
+std::vector<std::string>
+ssr::instance_keys(const std::vector<detected_object>& objects)
+{
+    std::unordered_map<std::string, unsigned int> occurrences;
+    std::vector<std::string> keys;
+    keys.reserve(objects.size());
+
+    for (const detected_object& object : objects)
+    {
+        const unsigned int occurrence = occurrences[object.instance_name]++;
+        if (occurrence == 0)
+            keys.push_back(object.instance_name);
+        else
+            keys.push_back(object.instance_name + "#" + std::to_string(occurrence));
+    }
+
+    return keys;
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/functions.h>
+
+
+// STD/STL
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace corcal::core;
+
+
+ssr::previous_frame_match
+ssr::match_previous_frame(
+    const std::vector<std::string>& keys,
+    const std::vector<std::string>& previous_keys,
+    std::unordered_map<std::string, std::size_t>& previous_index)
+{
+    previous_index.clear();
+    for (std::size_t i = 0; i < previous_keys.size(); ++i)
+        previous_index.emplace(previous_keys[i], i);
+
+    previous_frame_match match;
+    match.previous.assign(keys.size(), ssr::no_previous_index);
+    match.still_present.assign(previous_keys.size(), false);
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        const auto it = previous_index.find(keys[i]);
+        if (it != previous_index.end())
+        {
+            match.previous[i] = it->second;
+            match.still_present[it->second] = true;
+        }
+    }
+
+    return match;
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#include <corcal/core/ssr/functions.h>
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+// corcal
+#include <corcal/core/ssr.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    /**
+     * @brief Bit 7 is not used by any relation, so it marks a run of empty cells in a run-length encoded matrix
+     */
+    const std::uint16_t run_bit = 1u << 7;
+
+    /**
+     * @brief Longest run of empty cells a single word can hold (15 bit)
+     */
+    const std::size_t max_run_length = (1u << 15) - 1;
+
+
+    Ice::Short
+    to_word(std::uint16_t value)
+    {
+        return static_cast<Ice::Short>(static_cast<std::int16_t>(value));
+    }
+
+
+    /**
+     * @brief Run word, where the lower 7 bit of the length are stored below the run bit and the upper 8 bit above
+     */
+    Ice::Short
+    run_word(std::size_t length)
+    {
+        const std::uint16_t low = static_cast<std::uint16_t>(length & 0x7f);
+        const std::uint16_t high = static_cast<std::uint16_t>(length >> 7);
+        return ::to_word(static_cast<std::uint16_t>(run_bit | low | (high << 8)));
+    }
+}
+
+
+ssr_matrix_packed
+ssr::pack(const ssr::ssr_matrix& ssr_matrix, const bool run_length_encode)
+{
+    const std::size_t dim = ssr_matrix.dim();
+
+    ssr_matrix_packed packed;
+    packed.dim = static_cast<int>(dim);
+    packed.run_length_encoded = run_length_encode;
+    if (not run_length_encode and dim > 1)
+        packed.cells.reserve(dim * (dim - 1) / 2);
+
+    std::size_t run_length = 0;
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+        for (std::size_t j = i + 1; j < dim; ++j)
+        {
+            const relations& rel = ssr_matrix(i, j);
+
+            if (not run_length_encode)
+            {
+                packed.cells.push_back(::to_word(rel.mask()));
+                continue;
+            }
+
+            ARMARX_CHECK_EXPRESSION_W_HINT((rel.mask() & ::run_bit) == 0,
+                "Relation bit " + std::to_string(::run_bit) + " is reserved for run-length encoding");
+
+            if (rel.mask() == 0)
+            {
+                if (++run_length == ::max_run_length)
+                {
+                    packed.cells.push_back(::run_word(run_length));
+                    run_length = 0;
+                }
+            }
+            else
+            {
+                if (run_length > 0)
+                {
+                    packed.cells.push_back(::run_word(run_length));
+                    run_length = 0;
+                }
+                packed.cells.push_back(::to_word(rel.mask()));
+            }
+        }
+    }
+
+    if (run_length > 0)
+        packed.cells.push_back(::run_word(run_length));
+
+    return packed;
+}
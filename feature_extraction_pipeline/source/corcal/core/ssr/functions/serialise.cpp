@@ -24,6 +24,10 @@
 #include <corcal/core/ssr/functions.h>
 
 
+// STD/STL
+#include <cstddef>
+#include <vector>
+
 // corcal
 #include <corcal/core/ssr.h>
 
@@ -32,13 +36,17 @@ using namespace corcal::core;
 
 
 std::vector<std::vector<int>>
-ssr::serialise(const std::vector<std::vector<relations>>& ssr_matrix)
+ssr::serialise(const ssr::ssr_matrix& ssr_matrix)
 {
-    const unsigned long dim = ssr_matrix.size();
-    std::vector<std::vector<int>> serialised_ssr_matrix{dim, std::vector<int>(dim)};
-
-    for (unsigned int i = 0; i < ssr_matrix.size(); ++i) for (unsigned int j = 0; j < ssr_matrix.size(); ++j)
-        serialised_ssr_matrix.at(i).at(j) = ssr_matrix.at(i).at(j);
+    const std::size_t dim = ssr_matrix.dim();
+    std::vector<std::vector<int>> serialised_ssr_matrix(dim);
+
+    // Rows are contiguous in the ssr_matrix, so each row is converted in one bulk copy
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+        const relations* row_begin = ssr_matrix.data() + i * dim;
+        serialised_ssr_matrix[i].assign(row_begin, row_begin + dim);
+    }
 
     return serialised_ssr_matrix;
 }
@@ -0,0 +1,115 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#include <corcal/core/ssr/functions.h>
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+// corcal
+#include <corcal/core/ssr.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    const std::uint16_t run_bit = 1u << 7;
+}
+
+
+ssr::ssr_matrix
+ssr::unpack(const ssr_matrix_packed& ssr_matrix)
+{
+    ARMARX_CHECK_GREATER_EQUAL(ssr_matrix.dim, 0);
+
+    const std::size_t dim = static_cast<std::size_t>(ssr_matrix.dim);
+    const std::size_t cell_count = dim > 1 ? dim * (dim - 1) / 2 : 0;
+    ssr::ssr_matrix unpacked_ssr_matrix{dim};
+
+    // Position in the upper triangle, advanced cell by cell
+    std::size_t i = 0;
+    std::size_t j = 1;
+    std::size_t cells_done = 0;
+    const auto advance = [&](std::size_t count)
+    {
+        cells_done += count;
+        for (; count > 0; --count)
+        {
+            if (++j == dim)
+            {
+                ++i;
+                j = i + 1;
+            }
+        }
+    };
+
+    for (const Ice::Short word : ssr_matrix.cells)
+    {
+        const std::uint16_t value = static_cast<std::uint16_t>(word);
+
+        if (ssr_matrix.run_length_encoded and (value & ::run_bit) != 0)
+        {
+            const std::size_t run_length = (value & 0x7fu) | (static_cast<std::size_t>(value >> 8) << 7);
+            ARMARX_CHECK_LESS_EQUAL_W_HINT(cells_done + run_length, cell_count, "Packed SSR matrix is corrupt");
+            advance(run_length);
+            continue;
+        }
+
+        ARMARX_CHECK_LESS_W_HINT(cells_done, cell_count, "Packed SSR matrix is corrupt");
+
+        const relations rel{value};
+        unpacked_ssr_matrix(i, j) = rel;
+        unpacked_ssr_matrix(j, i) = rel.inverse();
+        advance(1);
+    }
+
+    ARMARX_CHECK_EQUAL_W_HINT(cells_done, cell_count, "Packed SSR matrix is incomplete");
+
+    return unpacked_ssr_matrix;
+}
+
+
+ssr::ssr_matrix
+ssr::unpack(const ssr_sparse_cell_list& cells, const std::size_t dim)
+{
+    ssr::ssr_matrix unpacked_ssr_matrix{dim};
+
+    for (const ssr_sparse_cell& cell : cells)
+    {
+        ARMARX_CHECK_GREATER_EQUAL(cell.subject_index, 0);
+        ARMARX_CHECK_GREATER_EQUAL(cell.object_index, 0);
+
+        unpacked_ssr_matrix.at(static_cast<std::size_t>(cell.subject_index),
+                               static_cast<std::size_t>(cell.object_index)) = relations{cell.mask};
+    }
+
+    return unpacked_ssr_matrix;
+}
@@ -24,6 +24,14 @@
 #include <corcal/core/ssr/functions.h>
 
 
+// STD/STL
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
 // corcal
 #include <corcal/core/ssr.h>
 
@@ -31,14 +39,18 @@
 using namespace corcal::core;
 
 
-std::vector<std::vector<relations>>
+ssr::ssr_matrix
 ssr::unserialise(const std::vector<std::vector<int>>& ssr_matrix)
 {
-    const unsigned long dim = ssr_matrix.size();
-    std::vector<std::vector<relations>> unserialised_ssr_matrix{dim, std::vector<relations>(dim)};
-
-    for (unsigned int i = 0; i < ssr_matrix.size(); ++i) for (unsigned int j = 0; j < ssr_matrix.size(); ++j)
-        unserialised_ssr_matrix.at(i).at(j) = ssr_matrix.at(i).at(j);
+    const std::size_t dim = ssr_matrix.size();
+    ssr::ssr_matrix unserialised_ssr_matrix{dim};
+
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+        const std::vector<int>& row = ssr_matrix[i];
+        ARMARX_CHECK_EQUAL_W_HINT(row.size(), dim, "Serialised SSR matrix must be square");
+        std::copy(row.begin(), row.end(), unserialised_ssr_matrix.data() + i * dim);
+    }
 
     return unserialised_ssr_matrix;
 }
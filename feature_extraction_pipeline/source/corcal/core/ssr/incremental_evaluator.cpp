@@ -0,0 +1,233 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#include <corcal/core/ssr/incremental_evaluator.h>
+
+
+// STD/STL
+#include <cmath>
+#include <utility>
+
+// corcal
+#include <corcal/core/ssr/functions.h>
+#include <corcal/core/ssr/kernel.h>
+
+
+using namespace corcal::core::ssr;
+using bounding_box = visionx::BoundingBox3D;
+
+
+namespace
+{
+    const std::size_t no_index = corcal::core::ssr::no_previous_index;
+
+
+    /**
+     * @brief Whether a coordinate moved more than epsilon.  NaN always counts as moved
+     */
+    bool
+    moved(float current, float reference, float epsilon)
+    {
+        return not (std::abs(current - reference) <= epsilon);
+    }
+
+
+    bool
+    moved(const bounding_box& current, const bounding_box& reference, float epsilon)
+    {
+        return ::moved(current.x0, reference.x0, epsilon) or ::moved(current.x1, reference.x1, epsilon)
+            or ::moved(current.y0, reference.y0, epsilon) or ::moved(current.y1, reference.y1, epsilon)
+            or ::moved(current.z0, reference.z0, epsilon) or ::moved(current.z1, reference.z1, epsilon);
+    }
+
+
+    kernel::box<float>
+    box_of(const bounding_box& bb)
+    {
+        return kernel::box<float>{bb.x0, bb.y0, bb.z0, bb.x1, bb.y1, bb.z1};
+    }
+}
+
+
+incremental_evaluator::incremental_evaluator(double distance_equality_threshold, float epsilon) :
+    m_distance_equality_threshold{distance_equality_threshold},
+    m_epsilon{epsilon},
+    m_dirty_count{0},
+    m_reused_count{0}
+{
+    // pass
+}
+
+
+const ssr_matrix&
+incremental_evaluator::evaluate(const std::vector<detected_object>& objects)
+{
+    const std::size_t dim = objects.size();
+    std::vector<std::string> keys = instance_keys(objects);
+
+    // Map each object to its row in the previous frame, or to no_index if it is dirty.  Clean objects keep the boxes
+    // their relations were evaluated with
+    std::vector<std::size_t> previous = match_previous_frame(keys, m_keys, m_previous_index).previous;
+    std::vector<bounding_box> bounding_boxes(dim);
+    std::vector<bounding_box> past_bounding_boxes(dim);
+    m_dirty_count = 0;
+
+    for (std::size_t i = 0; i < dim; ++i)
+    {
+        const detected_object& object = objects[i];
+
+        if (previous[i] != ::no_index
+            and not ::moved(object.bounding_box, m_bounding_boxes[previous[i]], m_epsilon)
+            and not ::moved(object.past_bounding_box, m_past_bounding_boxes[previous[i]], m_epsilon))
+        {
+            bounding_boxes[i] = m_bounding_boxes[previous[i]];
+            past_bounding_boxes[i] = m_past_bounding_boxes[previous[i]];
+        }
+        else
+        {
+            previous[i] = ::no_index;
+            bounding_boxes[i] = object.bounding_box;
+            past_bounding_boxes[i] = object.past_bounding_box;
+            ++m_dirty_count;
+        }
+    }
+
+    m_reused_count = 0;
+    if (m_dirty_count == dim)
+    {
+        // Nothing to reuse, and the reference boxes are the ones of the objects
+        m_ssr_matrix = evaluate_relations_fused(objects, m_distance_equality_threshold);
+    }
+    else
+    {
+        ssr_matrix next{dim};
+
+        for (std::size_t subject_index = 0; subject_index < dim; ++subject_index)
+        {
+            const std::size_t previous_subject_index = previous[subject_index];
+
+            for (std::size_t object_index = subject_index + 1; object_index < dim; ++object_index)
+            {
+                const std::size_t previous_object_index = previous[object_index];
+
+                if (previous_subject_index == ::no_index or previous_object_index == ::no_index)
+                {
+                    evaluate_pair(bounding_boxes[subject_index], past_bounding_boxes[subject_index],
+                                  bounding_boxes[object_index], past_bounding_boxes[object_index],
+                                  m_distance_equality_threshold,
+                                  next(subject_index, object_index), next(object_index, subject_index));
+                    continue;
+                }
+
+                if (previous_subject_index < previous_object_index)
+                {
+                    next(subject_index, object_index) = m_ssr_matrix(previous_subject_index, previous_object_index);
+                    next(object_index, subject_index) = m_ssr_matrix(previous_object_index, previous_subject_index);
+                }
+                else
+                {
+                    // The pair swapped its order, so the previous subject is the object now.  The subject of a pair
+                    // is always the object with the lower index, so the stored cell of the previous subject is reused
+                    // through its inverse.  Only inside / surround depend on which box is the subject, and are
+                    // decided anew
+                    relations rel = m_ssr_matrix(previous_object_index, previous_subject_index).inverse();
+                    rel.static_inside(false);
+                    rel.static_surround(false);
+                    relations rel_inv = rel.inverse();
+                    kernel::evaluate_containment_pair(::box_of(bounding_boxes[subject_index]),
+                                                      ::box_of(bounding_boxes[object_index]), rel, rel_inv);
+                    next(subject_index, object_index) = rel;
+                    next(object_index, subject_index) = rel_inv;
+                }
+                m_reused_count += 2;
+            }
+        }
+
+        m_ssr_matrix = std::move(next);
+    }
+
+    m_keys = std::move(keys);
+    m_bounding_boxes = std::move(bounding_boxes);
+    m_past_bounding_boxes = std::move(past_bounding_boxes);
+
+    return m_ssr_matrix;
+}
+
+
+void
+incremental_evaluator::reset()
+{
+    m_keys.clear();
+    m_bounding_boxes.clear();
+    m_past_bounding_boxes.clear();
+    m_ssr_matrix.reset(0);
+    m_dirty_count = 0;
+    m_reused_count = 0;
+}
+
+
+std::size_t
+incremental_evaluator::dirty_count() const
+{
+    return m_dirty_count;
+}
+
+
+std::size_t
+incremental_evaluator::reused_count() const
+{
+    return m_reused_count;
+}
+
+
+double
+incremental_evaluator::distance_equality_threshold() const
+{
+    return m_distance_equality_threshold;
+}
+
+
+void
+incremental_evaluator::distance_equality_threshold(double distance_equality_threshold)
+{
+    if (distance_equality_threshold != m_distance_equality_threshold)
+    {
+        m_distance_equality_threshold = distance_equality_threshold;
+        reset();
+    }
+}
+
+
+float
+incremental_evaluator::epsilon() const
+{
+    return m_epsilon;
+}
+
+
+void
+incremental_evaluator::epsilon(float epsilon)
+{
+    m_epsilon = epsilon;
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// VisionX
+#include <VisionX/interface/core/DataTypes.h>
+
+// corcal
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief Stateful SSR evaluator which only re-evaluates the rows and columns of objects that changed since the
+ *        previous frame
+ *
+ * Objects are identified across frames by their instance keys (see instance_keys).  An object is dirty if it appeared
+ * in this frame, or if any coordinate of its current or past bounding box moved more than epsilon away from the boxes
+ * its relations were last evaluated with.  All cells involving at least one dirty object are evaluated anew, all other
+ * cells are taken from the previous matrix, regardless of the order of the objects: cells of pairs which swapped their
+ * order are remapped through relations::inverse.  Disappeared objects are simply dropped.
+ *
+ * Clean objects keep the boxes their relations were evaluated with, so deviations never accumulate beyond epsilon.
+ * With an epsilon of 0, the results are identical to evaluate_relations.
+ */
+class incremental_evaluator
+{
+
+    private:
+
+        double m_distance_equality_threshold;
+        float m_epsilon;
+
+        /**
+         * @brief Instance keys of the previous frame, in the order of the rows of m_ssr_matrix
+         */
+        std::vector<std::string> m_keys;
+
+        /**
+         * @brief Bounding boxes the relations in m_ssr_matrix were evaluated with
+         */
+        std::vector<visionx::BoundingBox3D> m_bounding_boxes;
+        std::vector<visionx::BoundingBox3D> m_past_bounding_boxes;
+
+        ssr_matrix m_ssr_matrix;
+
+        /**
+         * @brief Number of objects re-evaluated in the last call to evaluate
+         */
+        std::size_t m_dirty_count;
+
+        /**
+         * @brief Number of cells taken from the previous matrix in the last call to evaluate
+         */
+        std::size_t m_reused_count;
+
+        /**
+         * @brief Scratch index from instance key to row in the previous frame, kept to reuse its buckets
+         */
+        std::unordered_map<std::string, std::size_t> m_previous_index;
+
+    public:
+
+        /**
+         * @param distance_equality_threshold As in evaluate_relations
+         * @param epsilon Distance in [mm] a bounding box coordinate may move without the object becoming dirty
+         */
+        explicit incremental_evaluator(double distance_equality_threshold, float epsilon = 0);
+
+        /**
+         * @brief Evaluates the SSR matrix of the given objects, reusing all cells of the previous frame that are
+         *        still valid
+         * @return SSR matrix in the order of objects, valid until the next call to evaluate or reset
+         */
+        const ssr_matrix& evaluate(const std::vector<detected_object>& objects);
+
+        /**
+         * @brief Forgets the previous frame, so that the next call to evaluate re-evaluates all objects
+         */
+        void reset();
+
+        /**
+         * @brief Number of objects which were re-evaluated in the last call to evaluate
+         */
+        std::size_t dirty_count() const;
+
+        /**
+         * @brief Number of cells which were taken from the previous frame in the last call to evaluate, where cells
+         *        of pairs which swapped their order count as well
+         */
+        std::size_t reused_count() const;
+
+        double distance_equality_threshold() const;
+
+        /**
+         * @brief Sets the distance equality threshold.  Resets the evaluator if it changed
+         */
+        void distance_equality_threshold(double);
+
+        float epsilon() const;
+
+        void epsilon(float);
+
+};
+
+
+}
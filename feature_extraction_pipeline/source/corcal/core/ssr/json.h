@@ -0,0 +1,151 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <string>
+
+// JSON
+#include <nlohmann/json.hpp>
+
+// corcal
+#include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+/**
+ * JSON conversion functions for the files cnnreplay writes and ssrsweep reads and writes.  Header only, so that
+ * corcal-core-ssr itself does not depend on nlohmann/json
+ */
+namespace visionx
+{
+
+
+inline void
+to_json(nlohmann::json& j, const visionx::BoundingBox3D& bb)
+{
+    j = nlohmann::json
+    {
+        {"x0", bb.x0},
+        {"y0", bb.y0},
+        {"z0", bb.z0},
+        {"x1", bb.x1},
+        {"y1", bb.y1},
+        {"z1", bb.z1}
+    };
+}
+
+
+inline void
+from_json(const nlohmann::json& j, visionx::BoundingBox3D& bb)
+{
+    j.at("x0").get_to(bb.x0);
+    j.at("y0").get_to(bb.y0);
+    j.at("z0").get_to(bb.z0);
+    j.at("x1").get_to(bb.x1);
+    j.at("y1").get_to(bb.y1);
+    j.at("z1").get_to(bb.z1);
+}
+
+
+}
+
+
+namespace corcal::core
+{
+
+
+inline void
+to_json(nlohmann::json& j, const detected_object& det)
+{
+    j = nlohmann::json
+    {
+        {"class_name", det.class_name},
+        {"class_index", det.class_index},
+        {"instance_name", det.instance_name},
+        {"certainty", det.certainty},
+        {"bounding_box", det.bounding_box},
+        {"past_bounding_box", det.past_bounding_box},
+        {"past_bounding_boxes", det.past_bounding_boxes},
+        {"colour", {det.colour.r, det.colour.g, det.colour.b}}
+    };
+}
+
+
+inline void
+from_json(const nlohmann::json& j, detected_object& det)
+{
+    j.at("class_name").get_to(det.class_name);
+    j.at("class_index").get_to(det.class_index);
+    j.at("instance_name").get_to(det.instance_name);
+    j.at("certainty").get_to(det.certainty);
+    j.at("bounding_box").get_to(det.bounding_box);
+    j.at("past_bounding_box").get_to(det.past_bounding_box);
+    det.colour = armarx::DrawColor24Bit{j["colour"][0], j["colour"][1], j["colour"][2]};
+
+    // Only written since catalyst exports several horizons
+    if (j.find("past_bounding_boxes") != j.end())
+        j.at("past_bounding_boxes").get_to(det.past_bounding_boxes);
+}
+
+
+}
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief Lists the relations of the SSR matrix as subject index, object index and relation name, one entry per
+ *        relation, in row-major order of the cells
+ */
+inline nlohmann::json
+relations_to_json(const ssr_matrix& ssr_matrix)
+{
+    nlohmann::json rels = nlohmann::json::array();
+
+    for (unsigned int i = 0; i < ssr_matrix.dim(); ++i) for (unsigned int j = 0; j < ssr_matrix.dim(); ++j)
+    {
+        // Skip if i equals j (no self-relations).
+        if (i == j) continue;
+
+        for (const relation relation : ssr_matrix(i, j))
+        {
+            rels.push_back(nlohmann::json
+            {
+                {"subject_index", i},
+                {"object_index", j},
+                {"relation_name", std::string{name_of(relation)}}
+            });
+        }
+    }
+
+    return rels;
+}
+
+
+}
@@ -0,0 +1,502 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// corcal
+#include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+
+
+/**
+ * Header-only SSR kernel, independent of the Ice types
+ *
+ * The kernel reads bounding boxes through a box accessor policy: any type with a value_type (float or double), a size()
+ * and an operator[](index) which returns a box<value_type>.  Policies for interleaved arrays, structure-of-arrays and
+ * ranges of arbitrary structs are provided below.  All functions of corcal::core::ssr which take detected_objects are
+ * adapters over this kernel or must stay bit-identical to it.
+ */
+namespace corcal::core::ssr::kernel
+{
+
+
+/**
+ * @brief Axis-aligned bounding box, with the coordinates in the order of visionx::BoundingBox3D
+ */
+template <typename T>
+struct box
+{
+    T x0;
+    T y0;
+    T z0;
+    T x1;
+    T y1;
+    T z1;
+};
+
+
+/**
+ * @brief Boxes stored as count × 6 consecutive values x0, y0, z0, x1, y1, z1, for example a float buffer of a
+ *        recording or a NumPy array of shape (count, 6)
+ */
+template <typename T>
+class interleaved_boxes
+{
+
+    private:
+
+        const T* m_data;
+        std::size_t m_size;
+
+    public:
+
+        using value_type = T;
+
+        interleaved_boxes(const T* data, std::size_t size) :
+            m_data{data}, m_size{size}
+        {
+            // pass
+        }
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        box<T> operator[](std::size_t index) const
+        {
+            const T* values = m_data + index * 6;
+            return box<T>{values[0], values[1], values[2], values[3], values[4], values[5]};
+        }
+
+};
+
+
+/**
+ * @brief Boxes stored as one array per coordinate
+ */
+template <typename T>
+class soa_boxes
+{
+
+    private:
+
+        const T* m_x0;
+        const T* m_y0;
+        const T* m_z0;
+        const T* m_x1;
+        const T* m_y1;
+        const T* m_z1;
+        std::size_t m_size;
+
+    public:
+
+        using value_type = T;
+
+        soa_boxes(const T* x0, const T* y0, const T* z0, const T* x1, const T* y1, const T* z1, std::size_t size) :
+            m_x0{x0}, m_y0{y0}, m_z0{z0}, m_x1{x1}, m_y1{y1}, m_z1{z1}, m_size{size}
+        {
+            // pass
+        }
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        box<T> operator[](std::size_t index) const
+        {
+            return box<T>{m_x0[index], m_y0[index], m_z0[index], m_x1[index], m_y1[index], m_z1[index]};
+        }
+
+};
+
+
+/**
+ * @brief Boxes projected from a contiguous array of elements, for example the bounding boxes of detected objects.  The
+ *        projection returns a reference to anything with the members x0, y0, z0, x1, y1 and z1
+ */
+template <typename Element, typename Projection, typename T = float>
+class projected_boxes
+{
+
+    private:
+
+        const Element* m_data;
+        std::size_t m_size;
+        Projection m_projection;
+
+    public:
+
+        using value_type = T;
+
+        projected_boxes(const Element* data, std::size_t size, Projection projection) :
+            m_data{data}, m_size{size}, m_projection{std::move(projection)}
+        {
+            // pass
+        }
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        box<T> operator[](std::size_t index) const
+        {
+            const auto& bb = m_projection(m_data[index]);
+            return box<T>{bb.x0, bb.y0, bb.z0, bb.x1, bb.y1, bb.z1};
+        }
+
+};
+
+
+template <typename T = float, typename Element, typename Projection>
+projected_boxes<Element, Projection, T>
+project_boxes(const std::vector<Element>& elements, Projection projection)
+{
+    return projected_boxes<Element, Projection, T>{elements.data(), elements.size(), std::move(projection)};
+}
+
+
+/**
+ * @brief Trivial collision check of two axis-aligned bounding boxes, equivalent to TNR in the paper
+ */
+template <typename T>
+inline bool
+is_colliding(const box<T>& a, const box<T>& b)
+{
+    return (a.x0 <= b.x1 and a.x1 >= b.x0 and
+            a.y0 <= b.y1 and a.y1 >= b.y0 and
+            a.z0 <= b.z1 and a.z1 >= b.z0);
+}
+
+
+template <typename T>
+struct centroid
+{
+    T x;
+    T y;
+    T z;
+};
+
+
+/**
+ * @brief Centre point of a bounding box, computed in the precision of the box
+ */
+template <typename T>
+inline centroid<T>
+centroid_of(const box<T>& bb)
+{
+    return centroid<T>{(bb.x1 + bb.x0) / 2, (bb.y1 + bb.y0) / 2, (bb.z1 + bb.z0) / 2};
+}
+
+
+/**
+ * @brief Distance between two centroids, equivalent to delta in the paper
+ *
+ * The differences are taken in the precision of the centroids and then squared in double precision, which is exact for
+ * floats, so that the result is bit-identical to the original single precision implementation.
+ */
+template <typename T>
+inline double
+distance_between(const centroid<T>& a, const centroid<T>& b)
+{
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    const double dz = a.z - b.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+
+/**
+ * @brief Everything about one object the pairwise evaluation needs, computed once per object
+ */
+template <typename T>
+struct object_summary
+{
+    box<T> bb;
+    box<T> past_bb;
+    centroid<T> centre;
+    centroid<T> past_centre;
+
+    /**
+     * @brief Whether the object moved less than half the distance equality threshold (p3 and p4 in
+     *        evaluate_dynamic_relations)
+     */
+    bool stood_still;
+};
+
+
+template <typename T>
+inline object_summary<T>
+summarise(const box<T>& bb, const box<T>& past_bb, double distance_equality_threshold)
+{
+    object_summary<T> summary;
+    summary.bb = bb;
+    summary.past_bb = past_bb;
+    summary.centre = centroid_of(bb);
+    summary.past_centre = centroid_of(past_bb);
+    summary.stood_still = distance_between(summary.centre, summary.past_centre) < (distance_equality_threshold / 2);
+    return summary;
+}
+
+
+/**
+ * @brief Inside / surround of a pair, the only relations whose result depends on which box is the subject
+ */
+template <typename T>
+inline void
+evaluate_containment_pair(const box<T>& subject_bb, const box<T>& object_bb, relations& rel, relations& rel_inv)
+{
+    if (object_bb.x0 < subject_bb.x0 and subject_bb.x1 < object_bb.x1 and object_bb.z0 < subject_bb.z0
+        and subject_bb.z1 < object_bb.z1 and object_bb.y0 < subject_bb.y0 and subject_bb.y0 <= object_bb.y1)
+    {
+        rel.static_inside(true);
+        rel_inv.static_surround(true);
+    }
+    else if (object_bb.x0 > subject_bb.x0 and subject_bb.x1 > object_bb.x1 and object_bb.z0 > subject_bb.z0
+        and subject_bb.z1 > object_bb.z1 and object_bb.y0 > subject_bb.y1 and subject_bb.y1 >= object_bb.y1)
+    {
+        rel.static_surround(true);
+        rel_inv.static_inside(true);
+    }
+}
+
+
+/**
+ * @brief Decides contact and the static relations of a pair, which do not depend on the distance equality threshold
+ *
+ * The decision logic must stay in sync with evaluate_{contact,static}_relations, where subject is the object with the
+ * lower index.
+ */
+template <typename T>
+inline void
+evaluate_static_pair(const box<T>& subject_bb, const box<T>& object_bb, bool colliding, relations& rel,
+                     relations& rel_inv)
+{
+    // Contact
+    if (colliding)
+    {
+        rel.contact(true);
+        rel_inv.contact(true);
+    }
+
+    // Left / right
+    if (subject_bb.x1 < object_bb.x0)
+    {
+        rel.static_left_of(true);
+        rel_inv.static_right_of(true);
+    }
+    else if (subject_bb.x0 > object_bb.x1)
+    {
+        rel.static_right_of(true);
+        rel_inv.static_left_of(true);
+    }
+
+    // Below / above
+    if (subject_bb.y1 < object_bb.y0)
+    {
+        rel.static_below(true);
+        rel_inv.static_above(true);
+    }
+    else if (subject_bb.y0 > object_bb.y1)
+    {
+        rel.static_above(true);
+        rel_inv.static_below(true);
+    }
+
+    // Behind / in front
+    if (subject_bb.z1 < object_bb.z0)
+    {
+        rel.static_behind_of(true);
+        rel_inv.static_in_front_of(true);
+    }
+    else if (subject_bb.z0 > object_bb.z1)
+    {
+        rel.static_in_front_of(true);
+        rel_inv.static_behind_of(true);
+    }
+
+    evaluate_containment_pair(subject_bb, object_bb, rel, rel_inv);
+}
+
+
+/**
+ * @brief Decides the dynamic relation of a pair which collided now and before, from whether each stood still
+ */
+inline relation
+colliding_dynamic_relation(bool subject_stood_still, bool object_stood_still)
+{
+    if (subject_stood_still and object_stood_still)
+        return relation::dynamic_moving_together;
+    else if (not subject_stood_still and not object_stood_still)
+        return relation::dynamic_halting_together;
+    else
+        return relation::dynamic_fixed_moving_together;
+}
+
+
+/**
+ * @brief Decides the dynamic relation of a pair which collided neither now nor before, from the change of their
+ *        distance
+ */
+inline relation
+separate_dynamic_relation(double distance_change, double distance_equality_threshold)
+{
+    if (distance_change < -distance_equality_threshold)
+        return relation::dynamic_getting_close;
+    else if (distance_change > distance_equality_threshold)
+        return relation::dynamic_moving_apart;
+    else
+        return relation::dynamic_stable;
+}
+
+
+/**
+ * @brief Decides the dynamic relation of a pair, given whether it collides now
+ *
+ * The decision logic must stay in sync with evaluate_dynamic_relations.  The relation is ORed into rel and rel_inv.
+ */
+template <typename T>
+inline void
+evaluate_dynamic_pair(const object_summary<T>& subject, const object_summary<T>& object, bool colliding,
+                      double distance_equality_threshold, relations& rel, relations& rel_inv)
+{
+    const bool colliding_past = is_colliding(subject.past_bb, object.past_bb);
+
+    // Dynamic relations are commutative
+    if (colliding and colliding_past)
+    {
+        const relation dynamic_relation = colliding_dynamic_relation(subject.stood_still, object.stood_still);
+        rel.set(dynamic_relation, true);
+        rel_inv.set(dynamic_relation, true);
+    }
+    else if (not colliding and not colliding_past)
+    {
+        const double delta = distance_between(subject.centre, object.centre);
+        const double delta_past = distance_between(subject.past_centre, object.past_centre);
+        const relation dynamic_relation = separate_dynamic_relation(delta - delta_past, distance_equality_threshold);
+        rel.set(dynamic_relation, true);
+        rel_inv.set(dynamic_relation, true);
+    }
+}
+
+
+/**
+ * @brief Decides all relations of a pair in one visit
+ *
+ * The decision logic must stay in sync with evaluate_{contact,static,dynamic}_relations, where subject is the object
+ * with the lower index.  The relations are ORed into rel and rel_inv.
+ */
+template <typename T>
+inline void
+evaluate_pair(const object_summary<T>& subject, const object_summary<T>& object, double distance_equality_threshold,
+              relations& rel, relations& rel_inv)
+{
+    const bool colliding = is_colliding(subject.bb, object.bb);
+
+    evaluate_static_pair(subject.bb, object.bb, colliding, rel, rel_inv);
+    evaluate_dynamic_pair(subject, object, colliding, distance_equality_threshold, rel, rel_inv);
+}
+
+
+/**
+ * @brief Evaluates all relations between the given boxes, passing each cell to store(subject, object, relations)
+ *        exactly once.  The diagonal is not passed
+ */
+template <typename Boxes, typename PastBoxes, typename Store>
+void
+evaluate_relations(const Boxes& boxes, const PastBoxes& past_boxes, double distance_equality_threshold, Store&& store)
+{
+    using T = typename Boxes::value_type;
+    static_assert(std::is_floating_point_v<T>, "Boxes must have float or double coordinates");
+    static_assert(std::is_same_v<T, typename PastBoxes::value_type>, "Current and past boxes must have the same type");
+
+    const std::size_t dim = boxes.size();
+
+    // Per-object precomputation in O(N): current and past centroids, and whether the object stood still
+    std::vector<object_summary<T>> summaries;
+    summaries.reserve(dim);
+    for (std::size_t index = 0; index < dim; ++index)
+        summaries.push_back(summarise(boxes[index], past_boxes[index], distance_equality_threshold));
+
+    for (std::size_t subject_index = 0; subject_index < dim; ++subject_index)
+    {
+        for (std::size_t object_index = subject_index + 1; object_index < dim; ++object_index)
+        {
+            relations rel;
+            relations rel_inv;
+            evaluate_pair(summaries[subject_index], summaries[object_index], distance_equality_threshold, rel,
+                          rel_inv);
+            store(subject_index, object_index, rel);
+            store(object_index, subject_index, rel_inv);
+        }
+    }
+}
+
+
+/**
+ * @brief Evaluates all relations between the given boxes into a row-major dim × dim array of 16 bit relation masks.
+ *        The diagonal is left untouched
+ */
+template <typename Boxes, typename PastBoxes>
+void
+evaluate_relations(const Boxes& boxes, const PastBoxes& past_boxes, double distance_equality_threshold,
+                   std::uint16_t* masks)
+{
+    const std::size_t dim = boxes.size();
+    evaluate_relations(boxes, past_boxes, distance_equality_threshold,
+                       [masks, dim](std::size_t subject_index, std::size_t object_index, relations rel)
+                       {
+                           masks[subject_index * dim + object_index] = rel.mask();
+                       });
+}
+
+
+/**
+ * @brief Evaluates all relations between the given boxes into an SSR matrix
+ */
+template <typename Boxes, typename PastBoxes>
+ssr_matrix
+evaluate_relations(const Boxes& boxes, const PastBoxes& past_boxes, double distance_equality_threshold)
+{
+    ssr_matrix ssr_matrix{boxes.size()};
+    evaluate_relations(boxes, past_boxes, distance_equality_threshold,
+                       [&ssr_matrix](std::size_t subject_index, std::size_t object_index, relations rel)
+                       {
+                           ssr_matrix(subject_index, object_index) = rel;
+                       });
+    return ssr_matrix;
+}
+
+
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#include <corcal/core/ssr/object_series.h>
+
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+
+using namespace corcal::core;
+using namespace corcal::core::ssr;
+
+
+object_series::object_series() :
+    m_frame_offsets{0}
+{
+    // pass
+}
+
+
+void
+object_series::reserve(std::size_t frame_count, std::size_t object_count)
+{
+    m_frame_offsets.reserve(frame_count + 1);
+    m_bounding_boxes.reserve(object_count);
+    m_past_bounding_boxes.reserve(object_count);
+}
+
+
+void
+object_series::add_frame(const std::vector<detected_object>& objects)
+{
+    for (const detected_object& object : objects)
+    {
+        m_bounding_boxes.push_back(object.bounding_box);
+        m_past_bounding_boxes.push_back(object.past_bounding_box);
+    }
+
+    m_frame_offsets.push_back(m_bounding_boxes.size());
+}
+
+
+std::size_t
+object_series::frame_count() const
+{
+    return m_frame_offsets.size() - 1;
+}
+
+
+std::size_t
+object_series::object_count(std::size_t frame) const
+{
+    ARMARX_CHECK_LESS(frame, frame_count());
+    return m_frame_offsets[frame + 1] - m_frame_offsets[frame];
+}
+
+
+const visionx::BoundingBox3D*
+object_series::bounding_boxes(std::size_t frame) const
+{
+    ARMARX_CHECK_LESS(frame, frame_count());
+    return m_bounding_boxes.data() + m_frame_offsets[frame];
+}
+
+
+const visionx::BoundingBox3D*
+object_series::past_bounding_boxes(std::size_t frame) const
+{
+    ARMARX_CHECK_LESS(frame, frame_count());
+    return m_past_bounding_boxes.data() + m_frame_offsets[frame];
+}
+
+
+void
+object_series::clear()
+{
+    m_bounding_boxes.clear();
+    m_past_bounding_boxes.clear();
+    m_frame_offsets.assign(1, 0);
+}
@@ -0,0 +1,98 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <vector>
+
+// VisionX
+#include <VisionX/interface/core/DataTypes.h>
+
+// corcal
+#include <corcal/interface/data_structures.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief Compact buffer of the bounding boxes of all frames of a recording
+ *
+ * Only what the SSR evaluation needs is kept: The current and past bounding boxes of all objects of all frames, each
+ * in one contiguous array, and the offset of each frame into these arrays.
+ */
+class object_series
+{
+
+    private:
+
+        std::vector<visionx::BoundingBox3D> m_bounding_boxes;
+        std::vector<visionx::BoundingBox3D> m_past_bounding_boxes;
+
+        /**
+         * @brief Offset of each frame into the box arrays, followed by the total number of objects
+         */
+        std::vector<std::size_t> m_frame_offsets;
+
+    public:
+
+        object_series();
+
+        /**
+         * @brief Reserves space for the given number of frames and objects in total
+         */
+        void reserve(std::size_t frame_count, std::size_t object_count);
+
+        /**
+         * @brief Appends a frame
+         */
+        void add_frame(const std::vector<detected_object>& objects);
+
+        std::size_t frame_count() const;
+
+        /**
+         * @brief Number of objects in the given frame
+         */
+        std::size_t object_count(std::size_t frame) const;
+
+        /**
+         * @brief Current bounding boxes of the objects of the given frame, object_count(frame) many
+         */
+        const visionx::BoundingBox3D* bounding_boxes(std::size_t frame) const;
+
+        /**
+         * @brief Past bounding boxes of the objects of the given frame, object_count(frame) many
+         */
+        const visionx::BoundingBox3D* past_bounding_boxes(std::size_t frame) const;
+
+        void clear();
+
+};
+
+
+}
@@ -0,0 +1,279 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/relation_index.h>
+
+
+// STD/STL
+#include <algorithm>
+#include <utility>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+// corcal
+#include <corcal/core/ssr/functions.h>
+
+
+using namespace corcal::core;
+using namespace corcal::core::ssr;
+
+
+namespace
+{
+    const std::size_t no_index = corcal::core::ssr::no_previous_index;
+}
+
+
+relation_index::relation_index()
+{
+    // pass
+}
+
+
+void
+relation_index::update(const std::vector<detected_object>& objects, const ssr::ssr_matrix& ssr_matrix)
+{
+    ARMARX_CHECK_EQUAL_W_HINT(objects.size(), ssr_matrix.dim(), "SSR matrix does not match the objects");
+
+    const std::size_t dim = objects.size();
+    std::vector<std::string> keys = ssr::instance_keys(objects);
+
+    const auto [previous, still_present] = ssr::match_previous_frame(keys, m_keys, m_previous_index);
+
+    // Drop all relations from and to disappeared objects, then release their slots
+    for (std::size_t p = 0; p < m_keys.size(); ++p)
+    {
+        if (still_present[p])
+            continue;
+
+        for (std::size_t q = 0; q < m_keys.size(); ++q)
+        {
+            if (m_ssr_matrix(p, q).mask() != 0)
+                set_cell(m_slots[p], m_slots[q], relations{});
+            if (m_ssr_matrix(q, p).mask() != 0)
+                set_cell(m_slots[q], m_slots[p], relations{});
+        }
+    }
+    for (std::size_t p = 0; p < m_keys.size(); ++p)
+        if (not still_present[p])
+            release_slot(m_slots[p]);
+
+    std::vector<std::size_t> slots(dim);
+    for (std::size_t i = 0; i < dim; ++i)
+        slots[i] = previous[i] != ::no_index ? m_slots[previous[i]] : acquire_slot(keys[i]);
+
+    // Only touch the cells which changed.  Cells of new objects were empty
+    for (std::size_t i = 0; i < dim; ++i) for (std::size_t j = 0; j < dim; ++j)
+    {
+        if (i == j) continue;
+
+        const relations current = ssr_matrix(i, j);
+        const std::uint16_t before = previous[i] != ::no_index and previous[j] != ::no_index
+            ? m_ssr_matrix(previous[i], previous[j]).mask() : 0;
+
+        if (current.mask() != before)
+            set_cell(slots[i], slots[j], current);
+    }
+
+    m_keys = std::move(keys);
+    m_slots = std::move(slots);
+    m_ssr_matrix = ssr_matrix;
+}
+
+
+void
+relation_index::clear()
+{
+    m_keys.clear();
+    m_slots.clear();
+    m_ssr_matrix.reset(0);
+    m_slot_of.clear();
+    m_key_of_slot.clear();
+    m_free_slots.clear();
+    m_rows.clear();
+    m_objects.clear();
+    for (std::unordered_set<std::uint64_t>& pairs : m_pairs)
+        pairs.clear();
+}
+
+
+bool
+relation_index::contains(const std::string& instance_key) const
+{
+    return m_slot_of.count(instance_key) != 0;
+}
+
+
+std::size_t
+relation_index::size() const
+{
+    return m_keys.size();
+}
+
+
+std::size_t
+relation_index::count(relation rel) const
+{
+    return m_pairs[static_cast<std::size_t>(rel)].size();
+}
+
+
+std::vector<relation_index::instance_pair>
+relation_index::pairs(relation rel) const
+{
+    const std::unordered_set<std::uint64_t>& pairs = m_pairs[static_cast<std::size_t>(rel)];
+
+    std::vector<instance_pair> result;
+    result.reserve(pairs.size());
+    for (const std::uint64_t key : pairs)
+        result.emplace_back(m_key_of_slot[key >> 32], m_key_of_slot[key & 0xffffffff]);
+
+    return result;
+}
+
+
+const std::vector<std::string>&
+relation_index::objects_of(const std::string& subject_key, relation rel) const
+{
+    static const std::vector<std::string> none;
+
+    const auto it = m_slot_of.find(subject_key);
+    if (it == m_slot_of.end())
+        return none;
+
+    return m_objects[it->second][static_cast<std::size_t>(rel)];
+}
+
+
+std::vector<std::pair<std::string, relations>>
+relation_index::row(const std::string& subject_key) const
+{
+    std::vector<std::pair<std::string, relations>> result;
+
+    const auto it = m_slot_of.find(subject_key);
+    if (it == m_slot_of.end())
+        return result;
+
+    result.reserve(m_rows[it->second].size());
+    for (const auto& [object_slot, rels] : m_rows[it->second])
+        result.emplace_back(m_key_of_slot[object_slot], rels);
+
+    return result;
+}
+
+
+relations
+relation_index::between(const std::string& subject_key, const std::string& object_key) const
+{
+    const auto subject = m_slot_of.find(subject_key);
+    const auto object = m_slot_of.find(object_key);
+    if (subject == m_slot_of.end() or object == m_slot_of.end())
+        return relations{};
+
+    const auto cell = m_rows[subject->second].find(object->second);
+    return cell != m_rows[subject->second].end() ? cell->second : relations{};
+}
+
+
+std::size_t
+relation_index::acquire_slot(const std::string& key)
+{
+    std::size_t slot;
+    if (not m_free_slots.empty())
+    {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        m_key_of_slot[slot] = key;
+    }
+    else
+    {
+        slot = m_key_of_slot.size();
+        m_key_of_slot.push_back(key);
+        m_rows.emplace_back();
+        m_objects.emplace_back();
+    }
+
+    m_slot_of.emplace(key, slot);
+    return slot;
+}
+
+
+void
+relation_index::release_slot(std::size_t slot)
+{
+    ARMARX_CHECK_EXPRESSION_W_HINT(m_rows[slot].empty(), "Released slot still has relations");
+
+    m_slot_of.erase(m_key_of_slot[slot]);
+    m_key_of_slot[slot].clear();
+    m_free_slots.push_back(slot);
+}
+
+
+void
+relation_index::set_cell(std::size_t subject_slot, std::size_t object_slot, relations rels)
+{
+    std::unordered_map<std::size_t, relations>& row = m_rows[subject_slot];
+    const auto it = row.find(object_slot);
+    const std::uint16_t before = it != row.end() ? it->second.mask() : 0;
+
+    const std::uint64_t key = pair_key(subject_slot, object_slot);
+    const std::string& object_key = m_key_of_slot[object_slot];
+    for (const relation rel : relation_range<relation>{static_cast<std::uint16_t>(before & ~rels.mask())})
+    {
+        m_pairs[static_cast<std::size_t>(rel)].erase(key);
+
+        // Order within the posting list does not matter, so remove by swapping with the last entry
+        std::vector<std::string>& objects = m_objects[subject_slot][static_cast<std::size_t>(rel)];
+        const auto object = std::find(objects.begin(), objects.end(), object_key);
+        ARMARX_CHECK_EXPRESSION_W_HINT(object != objects.end(), "Posting list does not contain the object");
+        std::swap(*object, objects.back());
+        objects.pop_back();
+    }
+    for (const relation rel : relation_range<relation>{static_cast<std::uint16_t>(rels.mask() & ~before)})
+    {
+        m_pairs[static_cast<std::size_t>(rel)].insert(key);
+        m_objects[subject_slot][static_cast<std::size_t>(rel)].push_back(object_key);
+    }
+
+    if (rels.mask() == 0)
+    {
+        if (it != row.end())
+            row.erase(it);
+    }
+    else if (it != row.end())
+    {
+        it->second = rels;
+    }
+    else
+    {
+        row.emplace(object_slot, rels);
+    }
+}
+
+
+std::uint64_t
+relation_index::pair_key(std::size_t subject_slot, std::size_t object_slot)
+{
+    return (static_cast<std::uint64_t>(subject_slot) << 32) | static_cast<std::uint64_t>(object_slot);
+}
@@ -0,0 +1,161 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// corcal
+#include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief Inverted index of the relations of the most recent frame, answering per-relation and per-instance queries
+ *        without scanning the SSR matrix
+ *
+ * Maintains relation → set of (subject, object) pairs, instance → row of its non-empty cells, and (subject,
+ * relation) → objects.  Each update only touches the cells which changed since the previous frame, and queries take
+ * time proportional to their result (row queries to the number of related instances).
+ *
+ * Instances are identified by their instance keys (see instance_keys), which are the instance names unless names
+ * repeat within a frame.
+ */
+class relation_index
+{
+
+    public:
+
+        using instance_pair = std::pair<std::string, std::string>;
+
+    private:
+
+        /**
+         * @brief State of the previous frame
+         */
+        std::vector<std::string> m_keys;
+        std::vector<std::size_t> m_slots;
+        ssr_matrix m_ssr_matrix;
+
+        std::unordered_map<std::string, std::size_t> m_previous_index;
+
+        /**
+         * @brief Each known instance occupies a slot, which is released when it disappears
+         */
+        std::unordered_map<std::string, std::size_t> m_slot_of;
+        std::vector<std::string> m_key_of_slot;
+        std::vector<std::size_t> m_free_slots;
+
+        /**
+         * @brief Non-empty cells of each row by object slot, indexed by subject slot
+         */
+        std::vector<std::unordered_map<std::size_t, relations>> m_rows;
+
+        /**
+         * @brief Keys of the objects to which the subject has each relation bit, indexed by subject slot
+         */
+        std::vector<std::array<std::vector<std::string>, 16>> m_objects;
+
+        /**
+         * @brief Pairs of subject and object slot for each relation bit
+         */
+        std::array<std::unordered_set<std::uint64_t>, 16> m_pairs;
+
+    public:
+
+        relation_index();
+
+        /**
+         * @brief Replaces the indexed relations with those of the given frame
+         */
+        void update(const std::vector<detected_object>& objects, const ssr_matrix& ssr_matrix);
+
+        /**
+         * @brief Forgets all instances and relations
+         */
+        void clear();
+
+        bool contains(const std::string& instance_key) const;
+
+        /**
+         * @brief Number of instances in the most recent frame
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Number of pairs of which the relation holds
+         */
+        std::size_t count(relation rel) const;
+
+        /**
+         * @brief All pairs (subject, object) of which the relation holds, in no particular order
+         */
+        std::vector<instance_pair> pairs(relation rel) const;
+
+        /**
+         * @brief All objects to which the subject has the relation, in no particular order.  Valid until the next
+         *        call to update or clear
+         */
+        const std::vector<std::string>& objects_of(const std::string& subject_key, relation rel) const;
+
+        /**
+         * @brief All objects to which the subject has any relation, along with these relations
+         */
+        std::vector<std::pair<std::string, relations>> row(const std::string& subject_key) const;
+
+        /**
+         * @brief Relations of subject to object, none if either is unknown
+         */
+        relations between(const std::string& subject_key, const std::string& object_key) const;
+
+    private:
+
+        std::size_t acquire_slot(const std::string& key);
+
+        void release_slot(std::size_t slot);
+
+        /**
+         * @brief Sets the relations of a cell, updating the pairs of all relations that changed
+         */
+        void set_cell(std::size_t subject_slot, std::size_t object_slot, relations rels);
+
+        static std::uint64_t pair_key(std::size_t subject_slot, std::size_t object_slot);
+
+};
+
+
+}
@@ -21,32 +21,26 @@
  */
 
 
+
 #include <corcal/core/ssr/relations.h>
 
 
 // STD/STL
-#include <bitset>
+#include <cstdint>
 
 
 using namespace corcal::core::ssr;
 
 
 relations::relations() :
-    m_bitset{0}
+    m_mask{0}
 {
     // pass
 }
 
 
 relations::relations(int serialised_relations) :
-    m_bitset{static_cast<unsigned long long>(serialised_relations)}
-{
-    // pass
-}
-
-
-relations::relations(const relations_bitset& relations_bitset) :
-    m_bitset{relations_bitset}
+    m_mask{static_cast<std::uint16_t>(serialised_relations)}
 {
     // pass
 }
@@ -54,15 +48,15 @@ relations::relations(const relations_bitset& relations_bitset) :
 
 relations::operator int() const
 {
-    // This is safe as long as an int can hold the bitset (generally speaking, <= 32 bit)
-    return static_cast<int>(m_bitset.to_ulong());
+    // This is safe as long as an int can hold the mask (generally speaking, <= 32 bit)
+    return static_cast<int>(m_mask);
 }
 
 
 relations&
 relations::operator=(int serialised_relations)
 {
-    m_bitset = relations_bitset{static_cast<unsigned long long>(serialised_relations)};
+    m_mask = static_cast<std::uint16_t>(serialised_relations);
     return *this;
 }
 
@@ -70,217 +64,17 @@ relations::operator=(int serialised_relations)
 relations
 relations::filter(const relations& filter_mask) const
 {
-    return m_bitset bitand filter_mask.m_bitset;
-}
-
-
-void
-relations::contact(bool set_reset)
-{
-    m_bitset.set(contact_bit, set_reset);
-}
-
-
-bool
-relations::contact() const
-{
-    return m_bitset.test(contact_bit);
-}
-
-
-void
-relations::static_above(bool set_reset)
-{
-    m_bitset.set(static_above_bit, set_reset);
-}
-
-
-bool
-relations::static_above() const
-{
-    return m_bitset.test(static_above_bit);
-}
-
-
-void
-relations::static_below(bool set_reset)
-{
-    m_bitset.set(static_below_bit, set_reset);
-}
-
-
-bool
-relations::static_below() const
-{
-    return m_bitset.test(static_below_bit);
-}
-
-
-void
-relations::static_left_of(bool set_reset)
-{
-    m_bitset.set(static_left_of_bit, set_reset);
-}
-
-
-bool
-relations::static_left_of() const
-{
-    return m_bitset.test(static_left_of_bit);
-}
-
-
-void
-relations::static_right_of(bool set_reset)
-{
-    m_bitset.set(static_right_of_bit, set_reset);
-}
-
-
-bool
-relations::static_right_of() const
-{
-    return m_bitset.test(static_right_of_bit);
-}
-
-
-void
-relations::static_behind_of(bool set_reset)
-{
-    m_bitset.set(static_behind_of_bit, set_reset);
-}
-
-
-bool
-relations::static_behind_of() const
-{
-    return m_bitset.test(static_behind_of_bit);
-}
-
-
-void
-relations::static_in_front_of(bool set_reset)
-{
-    m_bitset.set(static_in_front_of_bit, set_reset);
-}
-
-
-bool
-relations::static_in_front_of() const
-{
-    return m_bitset.test(static_in_front_of_bit);
+    return relations{m_mask bitand filter_mask.m_mask};
 }
 
 
-void
-relations::static_inside(bool set_reset)
-{
-    m_bitset.set(static_inside_bit, set_reset);
-}
-
-
-bool
-relations::static_inside() const
-{
-    return m_bitset.test(static_inside_bit);
-}
-
-
-void
-relations::static_surround(bool set_reset)
-{
-    m_bitset.set(static_surround_bit, set_reset);
-}
-
-
-bool
-relations::static_surround() const
-{
-    return m_bitset.test(static_surround_bit);
-}
-
-
-void
-relations::dynamic_moving_together(bool set_reset)
-{
-    m_bitset.set(dynamic_moving_together_bit, set_reset);
-}
-
-
-bool
-relations::dynamic_moving_together() const
-{
-    return m_bitset.test(dynamic_moving_together_bit);
-}
-
-
-void
-relations::dynamic_halting_together(bool set_reset)
-{
-    m_bitset.set(dynamic_halting_together_bit, set_reset);
-}
-
-
-bool
-relations::dynamic_halting_together() const
-{
-    return m_bitset.test(dynamic_halting_together_bit);
-}
-
-
-void
-relations::dynamic_fixed_moving_together(bool set_reset)
-{
-    m_bitset.set(dynamic_fixed_moving_together_bit, set_reset);
-}
-
-
-bool
-relations::dynamic_fixed_moving_together() const
-{
-    return m_bitset.test(dynamic_fixed_moving_together_bit);
-}
-
-
-void
-relations::dynamic_getting_close(bool set_reset)
-{
-    m_bitset.set(dynamic_getting_close_bit, set_reset);
-}
-
-
-bool
-relations::dynamic_getting_close() const
-{
-    return m_bitset.test(dynamic_getting_close_bit);
-}
-
-
-void
-relations::dynamic_moving_apart(bool set_reset)
-{
-    m_bitset.set(dynamic_moving_apart_bit, set_reset);
-}
-
-
-bool
-relations::dynamic_moving_apart() const
-{
-    return m_bitset.test(dynamic_moving_apart_bit);
-}
-
-
-void
-relations::dynamic_stable(bool set_reset)
-{
-    m_bitset.set(dynamic_stable_bit, set_reset);
-}
-
-
-bool
-relations::dynamic_stable() const
+relations
+relations::inverse() const
 {
-    return m_bitset.test(dynamic_stable_bit);
+    relations inverted;
+    for (const relation rel : *this)
+        inverted.set(inverse_of(rel), true);
+    return inverted;
 }
 
 
@@ -289,34 +83,8 @@ relations::string_list() const
 {
     std::vector<std::string> v;
 
-    if (contact())
-        v.push_back("contact");
-    if (static_above())
-        v.push_back("above");
-    if (static_below())
-        v.push_back("below");
-    if (static_left_of())
-        v.push_back("left of");
-    if (static_right_of())
-        v.push_back("right of");
-    if (static_behind_of())
-        v.push_back("behind of");
-    if (static_in_front_of())
-        v.push_back("in front of");
-    if (static_surround())
-        v.push_back("surround");
-    if (dynamic_moving_together())
-        v.push_back("moving together");
-    if (dynamic_halting_together())
-        v.push_back("halting together");
-    if (dynamic_fixed_moving_together())
-        v.push_back("fixed moving together");
-    if (dynamic_getting_close())
-        v.push_back("getting close");
-    if (dynamic_moving_apart())
-        v.push_back("moving apart");
-    if (dynamic_stable())
-        v.push_back("stable");
+    for (const std::string_view name : names())
+        v.emplace_back(name);
 
     return v;
 }
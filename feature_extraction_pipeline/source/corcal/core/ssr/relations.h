@@ -21,69 +21,315 @@
  */
 
 
+
 #pragma once
 
 
 // STD/STL
-#include <bitset>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 
-namespace
+/**
+ * Schema of all relations, one X(identifier, bit, name, inverse, symmetric) entry per relation.  The enum, the
+ * schema table and the accessors of relations are generated from this list.
+ *
+ * Bit 7 is unused (it used to be "around", which is already implicitly encoded: around = above or below or left of or
+ * right of or behind of or in front of).
+ */
+#define CORCAL_SSR_RELATION_SCHEMA(X) \
+    X(contact,                       0,  "contact",               contact,                       true) \
+    X(static_above,                  1,  "above",                 static_below,                  false) \
+    X(static_below,                  2,  "below",                 static_above,                  false) \
+    X(static_left_of,                3,  "left of",               static_right_of,               false) \
+    X(static_right_of,               4,  "right of",              static_left_of,                false) \
+    X(static_behind_of,              5,  "behind of",             static_in_front_of,            false) \
+    X(static_in_front_of,            6,  "in front of",           static_behind_of,              false) \
+    X(static_inside,                 8,  "inside",                static_surround,               false) \
+    X(static_surround,               9,  "surround",              static_inside,                 false) \
+    X(dynamic_moving_together,       10, "moving together",       dynamic_moving_together,       true) \
+    X(dynamic_halting_together,      11, "halting together",      dynamic_halting_together,      true) \
+    X(dynamic_fixed_moving_together, 12, "fixed moving together", dynamic_fixed_moving_together, true) \
+    X(dynamic_getting_close,         13, "getting close",         dynamic_getting_close,         true) \
+    X(dynamic_moving_apart,          14, "moving apart",          dynamic_moving_apart,          true) \
+    X(dynamic_stable,                15, "stable",                dynamic_stable,                true)
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief All relations, where the value of each enumerator is its bit index in the relations mask
+ */
+enum class relation : std::uint8_t
+{
+#define CORCAL_SSR_RELATION_ENUMERATOR(identifier, bit, name, inverse, symmetric) identifier = bit,
+    CORCAL_SSR_RELATION_SCHEMA(CORCAL_SSR_RELATION_ENUMERATOR)
+#undef CORCAL_SSR_RELATION_ENUMERATOR
+};
+
+
+struct relation_schema_entry
 {
-    const unsigned int relations_count = 16;
+    relation id;
+    std::string_view identifier;
+    unsigned int bit;
+    std::string_view name;
+    relation inverse;
+    bool symmetric;
+};
 
-    /**
-     * Typedef for a bitset large enough to hold all relations
-     */
-    using relations_bitset = std::bitset<relations_count>;
+
+/**
+ * @brief Schema table of all relations, ordered by bit index
+ */
+inline constexpr relation_schema_entry relation_schema[] =
+{
+#define CORCAL_SSR_RELATION_SCHEMA_ENTRY(identifier, bit, name, inverse, symmetric) \
+    {relation::identifier, #identifier, bit, name, relation::inverse, symmetric},
+    CORCAL_SSR_RELATION_SCHEMA(CORCAL_SSR_RELATION_SCHEMA_ENTRY)
+#undef CORCAL_SSR_RELATION_SCHEMA_ENTRY
+};
+
+
+/**
+ * @brief Number of relations
+ */
+inline constexpr std::size_t relations_count = std::size(relation_schema);
+
+
+constexpr std::uint16_t
+mask_of(relation rel)
+{
+    return static_cast<std::uint16_t>(1u << static_cast<unsigned int>(rel));
 }
 
 
-namespace corcal { namespace core { namespace ssr
+constexpr const relation_schema_entry&
+schema_of(relation rel)
 {
+    std::size_t index = 0;
+    while (relation_schema[index].id != rel)
+        ++index;
+    return relation_schema[index];
+}
 
 
-class relations
+constexpr std::string_view
+name_of(relation rel)
+{
+    return schema_of(rel).name;
+}
+
+
+constexpr relation
+inverse_of(relation rel)
+{
+    return schema_of(rel).inverse;
+}
+
+
+constexpr bool
+is_symmetric(relation rel)
+{
+    return schema_of(rel).symmetric;
+}
+
+
+/**
+ * @brief Mask of all relations whose identifier starts with the given prefix
+ */
+constexpr std::uint16_t
+mask_with_prefix(std::string_view prefix)
+{
+    std::uint16_t mask = 0;
+    for (const relation_schema_entry& entry : relation_schema)
+        if (entry.identifier.substr(0, prefix.size()) == prefix)
+            mask |= mask_of(entry.id);
+    return mask;
+}
+
+
+inline constexpr std::uint16_t all_relations_mask = mask_with_prefix("");
+inline constexpr std::uint16_t static_relations_mask = mask_with_prefix("static_");
+inline constexpr std::uint16_t dynamic_relations_mask = mask_with_prefix("dynamic_");
+
+
+/**
+ * @brief Mask of all relations which are their own inverse
+ */
+constexpr std::uint16_t
+symmetric_mask()
 {
+    std::uint16_t mask = 0;
+    for (const relation_schema_entry& entry : relation_schema)
+        if (entry.symmetric)
+            mask |= mask_of(entry.id);
+    return mask;
+}
+
+
+inline constexpr std::uint16_t symmetric_relations_mask = symmetric_mask();
+
+
+/**
+ * @brief Whether each entry sits at its bit, and inverse relations pair up as expected
+ */
+constexpr bool
+is_consistent_schema()
+{
+    for (const relation_schema_entry& entry : relation_schema)
+    {
+        if (static_cast<unsigned int>(entry.id) != entry.bit
+            or inverse_of(entry.inverse) != entry.id
+            or entry.symmetric != (entry.inverse == entry.id))
+            return false;
+    }
+    return true;
+}
+
+
+static_assert(is_consistent_schema(), "Relation schema is inconsistent");
+static_assert(relations_count == 15, "Relation schema is incomplete");
+static_assert((all_relations_mask & (1u << 7)) == 0, "Bit 7 must stay unused");
+
+
+/**
+ * @brief Iterator over the set bits of a relations mask, yielding either the relation or its name.  Does not allocate
+ */
+template <typename T>
+class relation_iterator
+{
+
+    static_assert(std::is_same_v<T, relation> or std::is_same_v<T, std::string_view>,
+                  "relation_iterator yields relation or std::string_view");
 
     private:
 
+        std::uint16_t m_remaining;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = T;
+
         /**
-         * Typedef for a bitset large enough to hold all relations
+         * @brief Iterates over the bits of mask which belong to a relation of the schema
          */
-        using relations_bitset = ::relations_bitset;
-
-        // Constants for relations
-        static const unsigned int contact_bit = 0;
-        static const unsigned int static_above_bit = 1;
-        static const unsigned int static_below_bit = 2;
-        static const unsigned int static_left_of_bit = 3;
-        static const unsigned int static_right_of_bit = 4;
-        static const unsigned int static_behind_of_bit = 5;
-        static const unsigned int static_in_front_of_bit = 6;
-        //static const unsigned int static_around_bit = 7; // removed because already implicitly encoded:
-                                                           // around = above or below or right or left or behind ...
-        static const unsigned int static_inside_bit = 8;
-        static const unsigned int static_surround_bit = 9;
-        static const unsigned int dynamic_moving_together_bit = 10;
-        static const unsigned int dynamic_halting_together_bit = 11;
-        static const unsigned int dynamic_fixed_moving_together_bit = 12;
-        static const unsigned int dynamic_getting_close_bit = 13;
-        static const unsigned int dynamic_moving_apart_bit = 14;
-        static const unsigned int dynamic_stable_bit = 15;
+        constexpr explicit relation_iterator(std::uint16_t mask) :
+            m_remaining{static_cast<std::uint16_t>(mask & all_relations_mask)}
+        {
+            // pass
+        }
+
+        constexpr T operator*() const
+        {
+            const relation rel = static_cast<relation>(__builtin_ctz(m_remaining));
+            if constexpr (std::is_same_v<T, std::string_view>)
+                return name_of(rel);
+            else
+                return rel;
+        }
+
+        constexpr relation_iterator& operator++()
+        {
+            // Clear the lowest set bit
+            m_remaining = static_cast<std::uint16_t>(m_remaining & (m_remaining - 1));
+            return *this;
+        }
+
+        constexpr relation_iterator operator++(int)
+        {
+            relation_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        constexpr bool operator==(const relation_iterator& other) const
+        {
+            return m_remaining == other.m_remaining;
+        }
+
+        constexpr bool operator!=(const relation_iterator& other) const
+        {
+            return m_remaining != other.m_remaining;
+        }
+
+};
+
+
+/**
+ * @brief Range over the set bits of a relations mask
+ */
+template <typename T>
+class relation_range
+{
+
+    private:
+
+        std::uint16_t m_mask;
+
+    public:
+
+        constexpr explicit relation_range(std::uint16_t mask) :
+            m_mask{mask}
+        {
+            // pass
+        }
+
+        constexpr relation_iterator<T> begin() const
+        {
+            return relation_iterator<T>{m_mask};
+        }
+
+        constexpr relation_iterator<T> end() const
+        {
+            return relation_iterator<T>{0};
+        }
+
+};
+
+
+class relations
+{
+
+    public:
+
+        using iterator = relation_iterator<relation>;
+        using const_iterator = relation_iterator<relation>;
+
+    private:
 
         /**
-         * @brief Active relations represented by a bitset, where HI means that the given relation is active, and LO
-         *        that a given relation is not active
+         * @brief Active relations represented by a bit mask, where HI means that the given relation is active, and LO
+         *        that a given relation is not active.  Kept as a plain 16 bit integer so that relations can be
+         *        stored densely in an ssr_matrix
          */
-        relations_bitset m_bitset;
+        std::uint16_t m_mask;
 
     public:
 
         unsigned long to_int() const
         {
-            return m_bitset.to_ulong();
+            return m_mask;
+        }
+
+        /**
+         * @brief Raw bit mask of the active relations
+         */
+        std::uint16_t mask() const
+        {
+            return m_mask;
         }
 
         /**
@@ -114,47 +360,55 @@ class relations
          */
         relations filter(const relations& filter_mask) const;
 
-        void contact(bool);
-        bool contact() const;
-        void static_above(bool);
-        bool static_above() const;
-        void static_below(bool);
-        bool static_below() const;
-        void static_left_of(bool);
-        bool static_left_of() const;
-        void static_right_of(bool);
-        bool static_right_of() const;
-        void static_behind_of(bool);
-        bool static_behind_of() const;
-        void static_in_front_of(bool);
-        bool static_in_front_of() const;
-        void static_inside(bool);
-        bool static_inside() const;
-        void static_surround(bool);
-        bool static_surround() const;
-        void dynamic_moving_together(bool);
-        bool dynamic_moving_together() const;
-        void dynamic_halting_together(bool);
-        bool dynamic_halting_together() const;
-        void dynamic_fixed_moving_together(bool);
-        bool dynamic_fixed_moving_together() const;
-        void dynamic_getting_close(bool);
-        bool dynamic_getting_close() const;
-        void dynamic_moving_apart(bool);
-        bool dynamic_moving_apart() const;
-        void dynamic_stable(bool);
-        bool dynamic_stable() const;
+        /**
+         * @brief Relations of the object to the subject, given these are the relations of the subject to the object
+         *
+         * Swaps each relation with its inverse according to the schema.  Contact and the dynamic relations are
+         * symmetric and stay as they are.
+         */
+        relations inverse() const;
 
-        std::vector<std::string> string_list() const;
+        void set(relation rel, bool set_reset)
+        {
+            m_mask = static_cast<std::uint16_t>(set_reset ? (m_mask | mask_of(rel)) : (m_mask & ~mask_of(rel)));
+        }
 
-    private:
+        bool test(relation rel) const
+        {
+            return (m_mask & mask_of(rel)) != 0;
+        }
+
+        // Named accessors, e.g. contact(bool) and contact(), generated from the schema
+#define CORCAL_SSR_RELATION_ACCESSORS(identifier, bit, name, inverse, symmetric) \
+        void identifier(bool set_reset) { set(relation::identifier, set_reset); } \
+        bool identifier() const { return test(relation::identifier); }
+        CORCAL_SSR_RELATION_SCHEMA(CORCAL_SSR_RELATION_ACCESSORS)
+#undef CORCAL_SSR_RELATION_ACCESSORS
 
         /**
-         * @brief Implementation-relevant constructor to construct a relations object from a bitset
+         * @brief Iterates over the active relations in the order of their bits, without allocating
          */
-        relations(const relations_bitset&);
+        const_iterator begin() const
+        {
+            return const_iterator{m_mask};
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator{0};
+        }
+
+        /**
+         * @brief Names of the active relations in the order of their bits, without allocating
+         */
+        relation_range<std::string_view> names() const
+        {
+            return relation_range<std::string_view>{m_mask};
+        }
+
+        std::vector<std::string> string_list() const;
 
 };
 
 
-}}}
+}
@@ -0,0 +1,353 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+// corcal
+#include <corcal/core/ssr/kernel.h>
+#include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief SSR evaluator for scenes of at most N objects, with N known at compile time (16, 32 or 64)
+ *
+ * Keeps the boxes in fixed structure-of-arrays storage and the relations as one bitset per relation and subject, so
+ * that evaluation does not allocate.  Each subject is tested against all N slots in one fixed-length, branch-free loop
+ * which the compiler can unroll and vectorise, and the slots beyond the scene are masked out afterwards.
+ *
+ * Results are bit-identical to kernel::evaluate_relations.  Only the upper triangle is evaluated, the cells below the
+ * diagonal are the inverses of the cells above.
+ */
+template <std::size_t N, typename T = float>
+class small_scene
+{
+
+    static_assert(N > 0 and N <= 64, "small_scene holds at most 64 objects");
+
+    public:
+
+        static constexpr std::size_t capacity = N;
+
+    private:
+
+        using word = std::uint64_t;
+
+        std::size_t m_size;
+
+        std::array<T, N> m_x0;
+        std::array<T, N> m_y0;
+        std::array<T, N> m_z0;
+        std::array<T, N> m_x1;
+        std::array<T, N> m_y1;
+        std::array<T, N> m_z1;
+
+        std::array<T, N> m_past_x0;
+        std::array<T, N> m_past_y0;
+        std::array<T, N> m_past_z0;
+        std::array<T, N> m_past_x1;
+        std::array<T, N> m_past_y1;
+        std::array<T, N> m_past_z1;
+
+        std::array<T, N> m_centre_x;
+        std::array<T, N> m_centre_y;
+        std::array<T, N> m_centre_z;
+        std::array<T, N> m_past_centre_x;
+        std::array<T, N> m_past_centre_y;
+        std::array<T, N> m_past_centre_z;
+
+        std::array<bool, N> m_stood_still;
+
+        /**
+         * @brief Bit j of m_rows[bit][i] is set if relation bit holds from subject i to object j, for i < j only
+         */
+        std::array<std::array<std::bitset<N>, N>, 16> m_rows;
+
+    public:
+
+        small_scene() :
+            m_size{0}
+        {
+            // pass
+        }
+
+        /**
+         * @brief Evaluates all relations between the given boxes, which must be at most N
+         */
+        template <typename Boxes, typename PastBoxes>
+        void evaluate(const Boxes& boxes, const PastBoxes& past_boxes, double distance_equality_threshold);
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        /**
+         * @brief Relations of subject to object
+         */
+        relations operator()(std::size_t subject, std::size_t object) const;
+
+        /**
+         * @brief Writes all cells into a row-major size × size array of 16 bit relation masks
+         */
+        void write(std::uint16_t* masks) const;
+
+        ssr_matrix to_ssr_matrix() const;
+
+};
+
+
+/**
+ * @brief Evaluates all relations between the given boxes with the smallest fitting small_scene, or with
+ *        kernel::evaluate_relations if there are more than 64
+ */
+template <typename Boxes, typename PastBoxes>
+ssr_matrix
+evaluate_relations_small_scene(const Boxes& boxes, const PastBoxes& past_boxes, double distance_equality_threshold);
+
+
+template <std::size_t N, typename T>
+template <typename Boxes, typename PastBoxes>
+void
+small_scene<N, T>::evaluate(const Boxes& boxes, const PastBoxes& past_boxes, double distance_equality_threshold)
+{
+    ARMARX_CHECK_LESS_EQUAL(boxes.size(), N);
+    m_size = boxes.size();
+
+    // Unused slots are zeroed, they are masked out below
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        const kernel::box<T> bb = i < m_size ? boxes[i] : kernel::box<T>{};
+        const kernel::box<T> past_bb = i < m_size ? past_boxes[i] : kernel::box<T>{};
+
+        m_x0[i] = bb.x0; m_y0[i] = bb.y0; m_z0[i] = bb.z0;
+        m_x1[i] = bb.x1; m_y1[i] = bb.y1; m_z1[i] = bb.z1;
+        m_past_x0[i] = past_bb.x0; m_past_y0[i] = past_bb.y0; m_past_z0[i] = past_bb.z0;
+        m_past_x1[i] = past_bb.x1; m_past_y1[i] = past_bb.y1; m_past_z1[i] = past_bb.z1;
+
+        const kernel::centroid<T> centre = kernel::centroid_of(bb);
+        const kernel::centroid<T> past_centre = kernel::centroid_of(past_bb);
+        m_centre_x[i] = centre.x; m_centre_y[i] = centre.y; m_centre_z[i] = centre.z;
+        m_past_centre_x[i] = past_centre.x; m_past_centre_y[i] = past_centre.y; m_past_centre_z[i] = past_centre.z;
+        m_stood_still[i] = kernel::distance_between(centre, past_centre) < (distance_equality_threshold / 2);
+    }
+
+    const word used = m_size == 64 ? ~word{0} : (word{1} << m_size) - 1;
+
+    // Rows of subjects beyond the scene are left stale, they are never read
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        // Objects j with i < j < size
+        const word valid = used & ~((word{2} << i) - 1);
+
+        const T x0 = m_x0[i], y0 = m_y0[i], z0 = m_z0[i], x1 = m_x1[i], y1 = m_y1[i], z1 = m_z1[i];
+        const T px0 = m_past_x0[i], py0 = m_past_y0[i], pz0 = m_past_z0[i];
+        const T px1 = m_past_x1[i], py1 = m_past_y1[i], pz1 = m_past_z1[i];
+        const bool stood_still = m_stood_still[i];
+
+        word contact = 0, left_of = 0, right_of = 0, below = 0, above = 0, behind_of = 0, in_front_of = 0;
+        word inside = 0, surround = 0;
+        word moving_together = 0, halting_together = 0, fixed_moving_together = 0;
+        word getting_close = 0, moving_apart = 0, stable = 0;
+
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            const bool colliding = (x0 <= m_x1[j]) & (x1 >= m_x0[j]) & (y0 <= m_y1[j]) & (y1 >= m_y0[j])
+                & (z0 <= m_z1[j]) & (z1 >= m_z0[j]);
+            const bool colliding_past = (px0 <= m_past_x1[j]) & (px1 >= m_past_x0[j]) & (py0 <= m_past_y1[j])
+                & (py1 >= m_past_y0[j]) & (pz0 <= m_past_z1[j]) & (pz1 >= m_past_z0[j]);
+
+            const bool left = x1 < m_x0[j];
+            const bool right = not left & (x0 > m_x1[j]);
+            const bool low = y1 < m_y0[j];
+            const bool high = not low & (y0 > m_y1[j]);
+            const bool back = z1 < m_z0[j];
+            const bool front = not back & (z0 > m_z1[j]);
+            const bool in = (m_x0[j] < x0) & (x1 < m_x1[j]) & (m_z0[j] < z0) & (z1 < m_z1[j]) & (m_y0[j] < y0)
+                & (y0 <= m_y1[j]);
+            const bool around = not in & (m_x0[j] > x0) & (x1 > m_x1[j]) & (m_z0[j] > z0) & (z1 > m_z1[j])
+                & (m_y0[j] > y1) & (y1 >= m_y1[j]);
+
+            // Dynamic relations, see kernel::evaluate_pair
+            const bool both = colliding & colliding_past;
+            const bool neither = not colliding & not colliding_past;
+            const bool together = both & stood_still & m_stood_still[j];
+            const bool halting = both & not stood_still & not m_stood_still[j];
+
+            const double dx = m_centre_x[i] - m_centre_x[j];
+            const double dy = m_centre_y[i] - m_centre_y[j];
+            const double dz = m_centre_z[i] - m_centre_z[j];
+            const double pdx = m_past_centre_x[i] - m_past_centre_x[j];
+            const double pdy = m_past_centre_y[i] - m_past_centre_y[j];
+            const double pdz = m_past_centre_z[i] - m_past_centre_z[j];
+            const double distance_change = std::sqrt(dx * dx + dy * dy + dz * dz)
+                - std::sqrt(pdx * pdx + pdy * pdy + pdz * pdz);
+            const bool close = neither & (distance_change < -distance_equality_threshold);
+            const bool apart = neither & not close & (distance_change > distance_equality_threshold);
+
+            contact |= static_cast<word>(colliding) << j;
+            left_of |= static_cast<word>(left) << j;
+            right_of |= static_cast<word>(right) << j;
+            below |= static_cast<word>(low) << j;
+            above |= static_cast<word>(high) << j;
+            behind_of |= static_cast<word>(back) << j;
+            in_front_of |= static_cast<word>(front) << j;
+            inside |= static_cast<word>(in) << j;
+            surround |= static_cast<word>(around) << j;
+            moving_together |= static_cast<word>(together) << j;
+            halting_together |= static_cast<word>(halting) << j;
+            fixed_moving_together |= static_cast<word>(both & not together & not halting) << j;
+            getting_close |= static_cast<word>(close) << j;
+            moving_apart |= static_cast<word>(apart) << j;
+            stable |= static_cast<word>(neither & not close & not apart) << j;
+        }
+
+        const auto store = [&](relation rel, word bits)
+        {
+            m_rows[static_cast<std::size_t>(rel)][i] = std::bitset<N>{bits & valid};
+        };
+        store(relation::contact, contact);
+        store(relation::static_left_of, left_of);
+        store(relation::static_right_of, right_of);
+        store(relation::static_below, below);
+        store(relation::static_above, above);
+        store(relation::static_behind_of, behind_of);
+        store(relation::static_in_front_of, in_front_of);
+        store(relation::static_inside, inside);
+        store(relation::static_surround, surround);
+        store(relation::dynamic_moving_together, moving_together);
+        store(relation::dynamic_halting_together, halting_together);
+        store(relation::dynamic_fixed_moving_together, fixed_moving_together);
+        store(relation::dynamic_getting_close, getting_close);
+        store(relation::dynamic_moving_apart, moving_apart);
+        store(relation::dynamic_stable, stable);
+    }
+}
+
+
+template <std::size_t N, typename T>
+relations
+small_scene<N, T>::operator()(std::size_t subject, std::size_t object) const
+{
+    if (subject > object)
+        return (*this)(object, subject).inverse();
+
+    relations rels;
+    if (subject == object)
+        return rels;
+
+    for (const relation rel : relation_range<relation>{all_relations_mask})
+        rels.set(rel, m_rows[static_cast<std::size_t>(rel)][subject][object]);
+    return rels;
+}
+
+
+template <std::size_t N, typename T>
+void
+small_scene<N, T>::write(std::uint16_t* masks) const
+{
+    const std::size_t dim = m_size;
+    for (std::size_t cell = 0; cell < dim * dim; ++cell)
+        masks[cell] = 0;
+
+    for (const relation rel : relation_range<relation>{all_relations_mask})
+    {
+        const std::uint16_t mask = mask_of(rel);
+        const std::uint16_t inverse_mask = mask_of(inverse_of(rel));
+        for (std::size_t i = 0; i < dim; ++i)
+        {
+            word bits = m_rows[static_cast<std::size_t>(rel)][i].to_ullong();
+            while (bits != 0)
+            {
+                const std::size_t j = static_cast<std::size_t>(__builtin_ctzll(bits));
+                masks[i * dim + j] |= mask;
+                masks[j * dim + i] |= inverse_mask;
+                bits &= bits - 1;
+            }
+        }
+    }
+}
+
+
+template <std::size_t N, typename T>
+ssr_matrix
+small_scene<N, T>::to_ssr_matrix() const
+{
+    ssr_matrix ssr_matrix{m_size};
+    for (const relation rel : relation_range<relation>{all_relations_mask})
+    {
+        const relation inverse = inverse_of(rel);
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            word bits = m_rows[static_cast<std::size_t>(rel)][i].to_ullong();
+            while (bits != 0)
+            {
+                const std::size_t j = static_cast<std::size_t>(__builtin_ctzll(bits));
+                ssr_matrix(i, j).set(rel, true);
+                ssr_matrix(j, i).set(inverse, true);
+                bits &= bits - 1;
+            }
+        }
+    }
+    return ssr_matrix;
+}
+
+
+template <typename Boxes, typename PastBoxes>
+ssr_matrix
+evaluate_relations_small_scene(const Boxes& boxes, const PastBoxes& past_boxes, double distance_equality_threshold)
+{
+    using T = typename Boxes::value_type;
+
+    const auto evaluate = [&](auto scene)
+    {
+        scene.evaluate(boxes, past_boxes, distance_equality_threshold);
+        return scene.to_ssr_matrix();
+    };
+
+    if (boxes.size() <= 16)
+        return evaluate(small_scene<16, T>{});
+    if (boxes.size() <= 32)
+        return evaluate(small_scene<32, T>{});
+    if (boxes.size() <= 64)
+        return evaluate(small_scene<64, T>{});
+    return kernel::evaluate_relations(boxes, past_boxes, distance_equality_threshold);
+}
+
+
+}
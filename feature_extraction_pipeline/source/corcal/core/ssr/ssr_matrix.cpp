@@ -0,0 +1,74 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/ssr_matrix.h>
+
+
+// STD/STL
+#include <algorithm>
+
+
+using namespace corcal::core::ssr;
+
+
+ssr_matrix::ssr_matrix() :
+    m_dim{0}
+{
+    // pass
+}
+
+
+ssr_matrix::ssr_matrix(std::size_t dim) :
+    m_dim{dim},
+    m_cells(dim * dim)
+{
+    // pass
+}
+
+
+void
+ssr_matrix::reset(std::size_t dim)
+{
+    m_dim = dim;
+    m_cells.assign(dim * dim, relations{});
+}
+
+
+bool
+ssr_matrix::operator==(const ssr_matrix& other) const
+{
+    return m_dim == other.m_dim and std::equal(
+        m_cells.begin(), m_cells.end(), other.m_cells.begin(),
+        [](const relations& a, const relations& b) -> bool
+        {
+            return a.mask() == b.mask();
+        }
+    );
+}
+
+
+bool
+ssr_matrix::operator!=(const ssr_matrix& other) const
+{
+    return not (*this == other);
+}
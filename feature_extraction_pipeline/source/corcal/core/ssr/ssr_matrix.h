@@ -0,0 +1,229 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// corcal
+#include <corcal/core/ssr/relations.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+static_assert(sizeof(relations) == sizeof(std::uint16_t), "relations must be stored as a plain 16 bit mask");
+
+
+/**
+ * @brief Non-owning view on a row or a column of an ssr_matrix
+ *
+ * Rows are contiguous (stride 1), columns are strided by the dimension of the matrix.
+ */
+template <typename T>
+class ssr_matrix_view
+{
+
+    private:
+
+        T* m_data;
+        std::size_t m_size;
+        std::size_t m_stride;
+
+    public:
+
+        ssr_matrix_view(T* data, std::size_t size, std::size_t stride) :
+            m_data{data}, m_size{size}, m_stride{stride}
+        {
+            // pass
+        }
+
+        std::size_t size() const
+        {
+            return m_size;
+        }
+
+        bool contiguous() const
+        {
+            return m_stride == 1;
+        }
+
+        T& operator[](std::size_t index) const
+        {
+            return m_data[index * m_stride];
+        }
+
+        T& at(std::size_t index) const
+        {
+            if (index >= m_size)
+                throw std::out_of_range{"ssr_matrix_view index " + std::to_string(index) + " out of range"};
+            return (*this)[index];
+        }
+
+};
+
+
+/**
+ * @brief Dense, row-major N×N matrix of relations
+ *
+ * All cells live in a single allocation.  Cell [i][j] holds the relations of subject i to object j.
+ */
+class ssr_matrix
+{
+
+    public:
+
+        using row_view = ssr_matrix_view<relations>;
+        using const_row_view = ssr_matrix_view<const relations>;
+        using column_view = ssr_matrix_view<relations>;
+        using const_column_view = ssr_matrix_view<const relations>;
+
+    private:
+
+        std::size_t m_dim;
+        std::vector<relations> m_cells;
+
+    public:
+
+        /**
+         * @brief Constructs an empty 0×0 matrix
+         */
+        ssr_matrix();
+
+        /**
+         * @brief Constructs a dim×dim matrix where no relation is active
+         */
+        explicit ssr_matrix(std::size_t dim);
+
+        /**
+         * @brief Resizes the matrix to dim×dim and resets all cells.  Keeps the allocation if possible
+         */
+        void reset(std::size_t dim);
+
+        /**
+         * @brief Number of rows (equals the number of columns)
+         */
+        std::size_t dim() const
+        {
+            return m_dim;
+        }
+
+        /**
+         * @brief Number of cells, that is dim²
+         */
+        std::size_t size() const
+        {
+            return m_cells.size();
+        }
+
+        relations& operator()(std::size_t i, std::size_t j)
+        {
+            return m_cells[i * m_dim + j];
+        }
+
+        const relations& operator()(std::size_t i, std::size_t j) const
+        {
+            return m_cells[i * m_dim + j];
+        }
+
+        relations& at(std::size_t i, std::size_t j)
+        {
+            check_bounds(i, j);
+            return (*this)(i, j);
+        }
+
+        const relations& at(std::size_t i, std::size_t j) const
+        {
+            check_bounds(i, j);
+            return (*this)(i, j);
+        }
+
+        /**
+         * @brief Transposed access, equivalent to at(j, i)
+         */
+        const relations& transposed_at(std::size_t i, std::size_t j) const
+        {
+            return at(j, i);
+        }
+
+        row_view row(std::size_t i)
+        {
+            check_bounds(i, 0);
+            return row_view{m_cells.data() + i * m_dim, m_dim, 1};
+        }
+
+        const_row_view row(std::size_t i) const
+        {
+            check_bounds(i, 0);
+            return const_row_view{m_cells.data() + i * m_dim, m_dim, 1};
+        }
+
+        column_view column(std::size_t j)
+        {
+            check_bounds(0, j);
+            return column_view{m_cells.data() + j, m_dim, m_dim};
+        }
+
+        const_column_view column(std::size_t j) const
+        {
+            check_bounds(0, j);
+            return const_column_view{m_cells.data() + j, m_dim, m_dim};
+        }
+
+        /**
+         * @brief Pointer to the row-major cell storage
+         */
+        relations* data()
+        {
+            return m_cells.data();
+        }
+
+        const relations* data() const
+        {
+            return m_cells.data();
+        }
+
+        bool operator==(const ssr_matrix& other) const;
+
+        bool operator!=(const ssr_matrix& other) const;
+
+    private:
+
+        void check_bounds(std::size_t i, std::size_t j) const
+        {
+            if (i >= m_dim or j >= m_dim)
+                throw std::out_of_range{"ssr_matrix index (" + std::to_string(i) + ", " + std::to_string(j)
+                    + ") out of range for dimension " + std::to_string(m_dim)};
+        }
+
+};
+
+
+}
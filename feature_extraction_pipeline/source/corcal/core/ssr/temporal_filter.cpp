@@ -0,0 +1,316 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/ssr/temporal_filter.h>
+
+
+// STD/STL
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+// corcal
+#include <corcal/core/ssr/functions.h>
+
+
+using namespace corcal::core;
+using namespace corcal::core::ssr;
+
+
+namespace
+{
+    const std::size_t no_index = corcal::core::ssr::no_previous_index;
+
+    /**
+     * @brief One plane per possible relation bit, so that planes are indexed by bit
+     */
+    const std::size_t planes = 16;
+
+    const std::size_t bits_per_word = 64;
+
+
+    std::size_t
+    words_for(std::size_t dim)
+    {
+        return (dim * dim + bits_per_word - 1) / bits_per_word;
+    }
+
+
+    bool
+    test_bit(const std::uint64_t* plane, std::size_t index)
+    {
+        return (plane[index / bits_per_word] >> (index % bits_per_word)) & 1;
+    }
+
+
+    void
+    set_bit(std::uint64_t* plane, std::size_t index)
+    {
+        plane[index / bits_per_word] |= std::uint64_t{1} << (index % bits_per_word);
+    }
+}
+
+
+temporal_filter::temporal_filter(std::size_t window, std::size_t on_count, std::size_t off_count) :
+    m_window{window},
+    m_on_count{on_count},
+    m_off_count{off_count},
+    m_levels{0},
+    m_dim{0},
+    m_words{0},
+    m_head{0},
+    m_suppressed_count{0}
+{
+    ARMARX_CHECK_EXPRESSION_W_HINT(window >= 1 and window <= max_temporal_filter_window,
+                                   "Window must hold between 1 and max_temporal_filter_window frames");
+    ARMARX_CHECK_EXPRESSION_W_HINT(off_count < on_count and on_count <= window,
+                                   "Thresholds must satisfy off_count < on_count <= window");
+
+    while ((std::size_t{1} << m_levels) <= window)
+        ++m_levels;
+}
+
+
+temporal_filter
+temporal_filter::majority(std::size_t window)
+{
+    return temporal_filter{window, window / 2 + 1, window / 2};
+}
+
+
+temporal_filter
+temporal_filter::hysteresis(std::size_t window)
+{
+    return temporal_filter{window, window, 0};
+}
+
+
+ssr::ssr_matrix
+temporal_filter::filter(const std::vector<detected_object>& objects, const ssr::ssr_matrix& ssr_matrix)
+{
+    ARMARX_CHECK_EQUAL_W_HINT(objects.size(), ssr_matrix.dim(), "SSR matrix does not match the objects");
+
+    std::vector<std::string> keys = ssr::instance_keys(objects);
+    if (keys != m_keys)
+        realign(keys);
+
+    const std::size_t dim = m_dim;
+    const std::size_t words = m_words;
+
+    // Slice the new frame into one plane per relation bit
+    m_sliced.assign(::planes * words, 0);
+    for (std::size_t cell = 0; cell < dim * dim; ++cell)
+        for (const relation rel : ssr_matrix.data()[cell])
+            ::set_bit(m_sliced.data() + static_cast<std::size_t>(rel) * words, cell);
+
+    ssr::ssr_matrix filtered{dim};
+    m_suppressed_count = 0;
+
+    for (const relation rel : relation_range<relation>{all_relations_mask})
+    {
+        const std::size_t bit = static_cast<std::size_t>(rel);
+        const std::uint64_t* plane = m_sliced.data() + bit * words;
+        std::uint64_t* oldest = history_plane(m_head, bit);
+        std::uint64_t* output = output_plane(bit);
+
+        for (std::size_t word = 0; word < words; ++word)
+        {
+            // Subtract the oldest frame, then add the new one.  Both ripple through the levels only as far as needed
+            std::uint64_t borrow = oldest[word];
+            for (std::size_t level = 0; level < m_levels and borrow != 0; ++level)
+            {
+                std::uint64_t& counter = counter_plane(bit, level)[word];
+                const std::uint64_t next = ~counter & borrow;
+                counter ^= borrow;
+                borrow = next;
+            }
+
+            std::uint64_t carry = plane[word];
+            for (std::size_t level = 0; level < m_levels and carry != 0; ++level)
+            {
+                std::uint64_t& counter = counter_plane(bit, level)[word];
+                const std::uint64_t next = counter & carry;
+                counter ^= carry;
+                carry = next;
+            }
+
+            oldest[word] = plane[word];
+
+            // Active if at least on_count, inactive if at most off_count, otherwise as before
+            output[word] = at_least(bit, word, m_on_count) | (output[word] & at_least(bit, word, m_off_count + 1));
+
+            std::uint64_t active = output[word];
+            m_suppressed_count += static_cast<std::size_t>(__builtin_popcountll(active ^ plane[word]));
+            while (active != 0)
+            {
+                const std::size_t cell = word * ::bits_per_word + static_cast<std::size_t>(__builtin_ctzll(active));
+                filtered.data()[cell].set(rel, true);
+                active &= active - 1;
+            }
+        }
+    }
+
+    m_head = (m_head + 1) % m_window;
+    return filtered;
+}
+
+
+void
+temporal_filter::reset()
+{
+    m_keys.clear();
+    m_dim = 0;
+    m_words = 0;
+    m_history.clear();
+    m_head = 0;
+    m_counters.clear();
+    m_output.clear();
+    m_suppressed_count = 0;
+}
+
+
+std::size_t
+temporal_filter::window() const
+{
+    return m_window;
+}
+
+
+std::size_t
+temporal_filter::suppressed_count() const
+{
+    return m_suppressed_count;
+}
+
+
+std::uint64_t*
+temporal_filter::history_plane(std::size_t frame, std::size_t bit)
+{
+    return m_history.data() + (frame * ::planes + bit) * m_words;
+}
+
+
+std::uint64_t*
+temporal_filter::counter_plane(std::size_t bit, std::size_t level)
+{
+    return m_counters.data() + (bit * m_levels + level) * m_words;
+}
+
+
+std::uint64_t*
+temporal_filter::output_plane(std::size_t bit)
+{
+    return m_output.data() + bit * m_words;
+}
+
+
+void
+temporal_filter::realign(const std::vector<std::string>& keys)
+{
+    const std::size_t previous_dim = m_dim;
+    const std::size_t previous_words = m_words;
+
+    std::unordered_map<std::string, std::size_t> previous_index;
+    const std::vector<std::size_t> previous = ssr::match_previous_frame(keys, m_keys, previous_index).previous;
+
+    const std::size_t dim = keys.size();
+    const std::size_t words = ::words_for(dim);
+
+    // Moves each plane of the given storage, of which there are count, to the new objects
+    const auto move_planes = [&](std::vector<std::uint64_t>& storage, std::size_t count)
+    {
+        std::vector<std::uint64_t> moved(count * words, 0);
+        for (std::size_t plane = 0; plane < count; ++plane)
+        {
+            const std::uint64_t* source = storage.data() + plane * previous_words;
+            std::uint64_t* target = moved.data() + plane * words;
+            for (std::size_t i = 0; i < dim; ++i) for (std::size_t j = 0; j < dim; ++j)
+                if (previous[i] != ::no_index and previous[j] != ::no_index
+                    and ::test_bit(source, previous[i] * previous_dim + previous[j]))
+                    ::set_bit(target, i * dim + j);
+        }
+        storage = std::move(moved);
+    };
+
+    if (m_history.empty())
+    {
+        m_history.assign(m_window * ::planes * words, 0);
+        m_output.assign(::planes * words, 0);
+    }
+    else
+    {
+        move_planes(m_history, m_window * ::planes);
+        move_planes(m_output, ::planes);
+    }
+
+    m_keys = keys;
+    m_dim = dim;
+    m_words = words;
+
+    // Recount the realigned history
+    m_counters.assign(::planes * m_levels * words, 0);
+    for (std::size_t frame = 0; frame < m_window; ++frame)
+    {
+        for (std::size_t bit = 0; bit < ::planes; ++bit)
+        {
+            const std::uint64_t* plane = history_plane(frame, bit);
+            for (std::size_t word = 0; word < words; ++word)
+            {
+                std::uint64_t carry = plane[word];
+                for (std::size_t level = 0; level < m_levels and carry != 0; ++level)
+                {
+                    std::uint64_t& counter = counter_plane(bit, level)[word];
+                    const std::uint64_t next = counter & carry;
+                    counter ^= carry;
+                    carry = next;
+                }
+            }
+        }
+    }
+}
+
+
+std::uint64_t
+temporal_filter::at_least(std::size_t bit, std::size_t word, std::size_t threshold)
+{
+    // Compare from the most significant level down, tracking which cells are already greater and which still equal
+    std::uint64_t greater = 0;
+    std::uint64_t equal = ~std::uint64_t{0};
+    for (std::size_t level = m_levels; level-- > 0;)
+    {
+        const std::uint64_t counter = counter_plane(bit, level)[word];
+        if ((threshold >> level) & 1)
+        {
+            equal &= counter;
+        }
+        else
+        {
+            greater |= equal & counter;
+            equal &= ~counter;
+        }
+    }
+    return greater | equal;
+}
@@ -0,0 +1,188 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// corcal
+#include <corcal/core/ssr/relations.h>
+#include <corcal/core/ssr/ssr_matrix.h>
+#include <corcal/interface/data_structures.h>
+
+
+namespace corcal::core::ssr
+{
+
+
+/**
+ * @brief How a temporal_filter decides whether a relation is active
+ */
+enum class temporal_filter_mode
+{
+    /**
+     * @brief Relations are passed through unfiltered
+     */
+    none,
+
+    /**
+     * @brief A relation is active if it was active in the majority of the last K frames
+     */
+    majority,
+
+    /**
+     * @brief A relation only becomes active after being active in all of the last K frames, and only becomes inactive
+     *        after being inactive in all of them
+     */
+    hysteresis
+};
+
+
+/**
+ * @brief Default number of frames a temporal_filter looks back
+ */
+inline constexpr std::size_t default_temporal_filter_window = 5;
+
+
+/**
+ * @brief Maximum number of frames a temporal_filter can look back
+ */
+inline constexpr std::size_t max_temporal_filter_window = 64;
+
+
+/**
+ * @brief Debounces flickering relations over the last K SSR matrices
+ *
+ * A relation of a pair becomes active once it was active in at least on_count of the last K frames, and becomes
+ * inactive once it was active in at most off_count of them.  In between, it keeps its previous filtered state.  Frames
+ * before the first one, or before an object appeared, count as frames without relations.
+ *
+ * The history is kept bit-sliced: one plane per relation bit and frame, with one bit per cell packed into 64 bit words.
+ * For each relation bit, the number of frames in which a cell was active is held in bit-sliced counters which are
+ * updated by adding the new plane and subtracting the one leaving the window, and compared against the thresholds,
+ * all 64 cells per word operation.
+ *
+ * Objects are identified across frames by their instance keys (see instance_keys).  If the objects change, the history
+ * is realigned to the new objects once.
+ */
+class temporal_filter
+{
+
+    private:
+
+        std::size_t m_window;
+        std::size_t m_on_count;
+        std::size_t m_off_count;
+
+        /**
+         * @brief Number of bits of each counter
+         */
+        std::size_t m_levels;
+
+        /**
+         * @brief Objects of the previous frame, and words per plane for their dimension
+         */
+        std::vector<std::string> m_keys;
+        std::size_t m_dim;
+        std::size_t m_words;
+
+        /**
+         * @brief Ring of the last K frames, each with one plane per relation bit
+         */
+        std::vector<std::uint64_t> m_history;
+        std::size_t m_head;
+
+        /**
+         * @brief Bit-sliced counters, m_levels planes per relation bit
+         */
+        std::vector<std::uint64_t> m_counters;
+
+        /**
+         * @brief Filtered planes of the previous frame
+         */
+        std::vector<std::uint64_t> m_output;
+
+        /**
+         * @brief Scratch planes of the new frame
+         */
+        std::vector<std::uint64_t> m_sliced;
+
+        std::size_t m_suppressed_count;
+
+    public:
+
+        /**
+         * @param window Number of frames K to look back
+         * @param on_count Number of frames out of K in which a relation must be active to become active
+         * @param off_count Number of frames out of K in which a relation may at most be active to become inactive
+         */
+        temporal_filter(std::size_t window, std::size_t on_count, std::size_t off_count);
+
+        static temporal_filter majority(std::size_t window = default_temporal_filter_window);
+
+        static temporal_filter hysteresis(std::size_t window = default_temporal_filter_window);
+
+        /**
+         * @brief Adds the given frame to the history and returns its filtered relations
+         */
+        ssr_matrix filter(const std::vector<detected_object>& objects, const ssr_matrix& ssr_matrix);
+
+        /**
+         * @brief Forgets the history
+         */
+        void reset();
+
+        std::size_t window() const;
+
+        /**
+         * @brief Number of relations of the last frame whose filtered state differs from the unfiltered one
+         */
+        std::size_t suppressed_count() const;
+
+    private:
+
+        std::uint64_t* history_plane(std::size_t frame, std::size_t bit);
+
+        std::uint64_t* counter_plane(std::size_t bit, std::size_t level);
+
+        std::uint64_t* output_plane(std::size_t bit);
+
+        /**
+         * @brief Moves the history and the filtered planes to the given objects, dropping those that disappeared
+         */
+        void realign(const std::vector<std::string>& keys);
+
+        /**
+         * @brief Whether the counters of the word are at least threshold, one bit per cell
+         */
+        std::uint64_t at_least(std::size_t bit, std::size_t word, std::size_t threshold);
+
+};
+
+
+}
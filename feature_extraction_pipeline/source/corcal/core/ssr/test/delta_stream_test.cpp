@@ -0,0 +1,126 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::test::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#define BOOST_TEST_MODULE corcal::test::core::ssr::delta_stream
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/ssr.h>
+#include <corcal/core/ssr/test/random_scene.h>
+
+
+using namespace corcal::core;
+
+
+BOOST_AUTO_TEST_CASE(decoder_reconstructs_encoded_frames)
+{
+    std::mt19937 rng{3};
+    ssr::delta_encoder encoder{10};
+    ssr::delta_decoder decoder;
+
+    std::vector<detected_object> objects;
+    for (unsigned int i = 0; i < 20; ++i)
+        objects.push_back(ssr::test::random_object(rng, "object_" + std::to_string(i)));
+
+    unsigned int next_name = 20;
+    for (unsigned int frame = 0; frame < 100; ++frame)
+    {
+        for (detected_object& object : objects)
+        {
+            if (rng() % 5 == 0)
+            {
+                object.past_bounding_box = object.bounding_box;
+                object.bounding_box.x0 += 40;
+                object.bounding_box.x1 += 40;
+            }
+        }
+        if (rng() % 3 == 0 and not objects.empty())
+            objects.erase(objects.begin() + rng() % objects.size());
+        if (rng() % 3 == 0)
+            objects.push_back(ssr::test::random_object(rng, "object_" + std::to_string(next_name++)));
+        if (rng() % 4 == 0)
+            std::shuffle(objects.begin(), objects.end(), rng);
+
+        const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30);
+        const ssr_delta delta = encoder.encode(objects, ssr_matrix, frame);
+
+        BOOST_CHECK_EQUAL(delta.keyframe, frame % 10 == 0);
+        BOOST_REQUIRE(decoder.apply(delta));
+        BOOST_CHECK(decoder.objects() == objects);
+        BOOST_CHECK(decoder.matrix() == ssr_matrix);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(decoder_waits_for_keyframe_after_lost_delta)
+{
+    std::mt19937 rng{5};
+    ssr::delta_encoder encoder{4};
+    ssr::delta_decoder decoder;
+
+    std::vector<detected_object> objects{ssr::test::random_object(rng, "a"), ssr::test::random_object(rng, "b")};
+    const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30);
+
+    BOOST_CHECK(decoder.apply(encoder.encode(objects, ssr_matrix, 0)));
+    encoder.encode(objects, ssr_matrix, 1);  // Lost
+    BOOST_CHECK(not decoder.apply(encoder.encode(objects, ssr_matrix, 2)));
+    BOOST_CHECK(not decoder.apply(encoder.encode(objects, ssr_matrix, 3)));
+    BOOST_CHECK(decoder.apply(encoder.encode(objects, ssr_matrix, 4)));
+    BOOST_CHECK(decoder.synchronised());
+}
+
+
+BOOST_AUTO_TEST_CASE(moved_objects_are_sent_as_bounding_boxes)
+{
+    std::mt19937 rng{7};
+    ssr::delta_encoder encoder{10};
+    ssr::delta_decoder decoder;
+
+    std::vector<detected_object> objects{ssr::test::random_object(rng, "a"), ssr::test::random_object(rng, "b")};
+    BOOST_REQUIRE(decoder.apply(encoder.encode(objects, evaluate_relations(objects, 30), 0)));
+
+    objects[0].past_bounding_box = objects[0].bounding_box;
+    objects[0].bounding_box.x0 += 40;
+    objects[0].bounding_box.x1 += 40;
+    objects[1].certainty = 0.5;
+
+    const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30);
+    const ssr_delta delta = encoder.encode(objects, ssr_matrix, 1);
+
+    BOOST_REQUIRE_EQUAL(delta.moved_objects.size(), 1);
+    BOOST_CHECK_EQUAL(delta.moved_objects[0].id, delta.object_order[0]);
+    BOOST_REQUIRE_EQUAL(delta.changed_objects.size(), 1);
+    BOOST_CHECK_EQUAL(delta.changed_objects[0].id, delta.object_order[1]);
+
+    BOOST_REQUIRE(decoder.apply(delta));
+    BOOST_CHECK(decoder.objects() == objects);
+    BOOST_CHECK(decoder.matrix() == ssr_matrix);
+}
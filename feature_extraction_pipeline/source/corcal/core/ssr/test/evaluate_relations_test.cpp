@@ -0,0 +1,494 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::test::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::ssr::evaluate_relations
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/ssr.h>
+#include <corcal/core/ssr/test/random_scene.h>
+
+
+using namespace corcal::core;
+
+
+BOOST_AUTO_TEST_CASE(fused_equals_three_pass)
+{
+    std::mt19937 rng{42};
+
+    for (unsigned int trial = 0; trial < 500; ++trial)
+    {
+        const unsigned int dim = rng() % 40;
+        const float extent = trial % 2 == 0 ? 2000 : 200;
+        const double threshold = 30;
+        const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, extent);
+
+        const ssr::ssr_matrix fused = evaluate_relations(objects, threshold, evaluation_strategy::fused);
+        const ssr::ssr_matrix three_pass = evaluate_relations(objects, threshold, evaluation_strategy::three_pass);
+
+        BOOST_CHECK(fused == three_pass);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(batched_static_relations_equal_individual_passes)
+{
+    std::mt19937 rng{7};
+
+    for (unsigned int trial = 0; trial < 200; ++trial)
+    {
+        const unsigned int dim = rng() % 70;
+        const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, 2000);
+
+        ssr::ssr_matrix expected{objects.size()};
+        evaluate_contact_relations(objects, expected);
+        evaluate_static_relations(objects, expected);
+
+        for (const instruction_set isa : {instruction_set::scalar, instruction_set::sse2, instruction_set::avx2,
+                                          instruction_set::avx512})
+        {
+            if (not is_supported(isa)) continue;
+
+            ssr::ssr_matrix batched{objects.size()};
+            evaluate_static_relations_batched(objects, batched, isa);
+
+            BOOST_CHECK_MESSAGE(batched == expected, "Mismatch with instruction set " + to_string(isa));
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(sweep_and_prune_equals_individual_passes)
+{
+    std::mt19937 rng{9};
+
+    for (unsigned int trial = 0; trial < 200; ++trial)
+    {
+        const unsigned int dim = rng() % 150;
+        const float extent = trial % 2 == 0 ? 2000 : 200;
+        const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, extent);
+
+        ssr::ssr_matrix expected{objects.size()};
+        evaluate_contact_relations(objects, expected);
+        evaluate_static_relations(objects, expected);
+
+        ssr::ssr_matrix swept{objects.size()};
+        evaluate_static_relations_sweep(objects, swept);
+
+        BOOST_CHECK(swept == expected);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(strategies_equal_fused_in_large_scenes)
+{
+    std::mt19937 rng{23};
+    const double threshold = 30;
+
+    for (unsigned int trial = 0; trial < 60; ++trial)
+    {
+        const unsigned int dim = 60 + rng() % 90;
+        const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, trial % 2 == 0 ? 2000 : 200);
+
+        const ssr::ssr_matrix fused = evaluate_relations(objects, threshold, evaluation_strategy::fused);
+        BOOST_CHECK(evaluate_relations(objects, threshold, evaluation_strategy::batched) == fused);
+        BOOST_CHECK(evaluate_relations(objects, threshold, evaluation_strategy::small_scene) == fused);
+        BOOST_CHECK(evaluate_relations(objects, threshold, evaluation_strategy::sweep) == fused);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(dynamic_relations_fused_equals_individual_pass)
+{
+    std::mt19937 rng{29};
+    const double threshold = 30;
+
+    for (unsigned int trial = 0; trial < 200; ++trial)
+    {
+        const unsigned int dim = rng() % 80;
+        const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, trial % 2 == 0 ? 2000 : 200);
+
+        ssr::ssr_matrix expected{objects.size()};
+        evaluate_contact_relations(objects, expected);
+        evaluate_dynamic_relations(objects, expected, threshold);
+
+        ssr::ssr_matrix fused{objects.size()};
+        evaluate_contact_relations(objects, fused);
+        evaluate_dynamic_relations_fused(objects, fused, threshold);
+
+        BOOST_CHECK(fused == expected);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(incremental_evaluator_equals_full_evaluation)
+{
+    std::mt19937 rng{11};
+    const double threshold = 30;
+    ssr::incremental_evaluator evaluator{threshold};
+
+    std::vector<detected_object> objects = ssr::test::random_scene(rng, 30, 1000);
+    const std::vector<detected_object> pool = ssr::test::random_scene(rng, 30, 1000);
+
+    for (unsigned int frame = 0; frame < 200; ++frame)
+    {
+        // Move a few objects, let one disappear or reappear, and reorder the list every now and then
+        for (detected_object& object : objects)
+        {
+            if (rng() % 8 == 0)
+            {
+                object.bounding_box.x0 += 10;
+                object.bounding_box.x1 += 10;
+            }
+        }
+        if (rng() % 3 == 0 and not objects.empty())
+            objects.erase(objects.begin() + rng() % objects.size());
+        if (rng() % 3 == 0)
+            objects.push_back(pool[rng() % pool.size()]);
+        if (rng() % 4 == 0)
+            std::shuffle(objects.begin(), objects.end(), rng);
+
+        const ssr::ssr_matrix& incremental = evaluator.evaluate(objects);
+
+        BOOST_CHECK(incremental == evaluate_relations(objects, threshold));
+        BOOST_CHECK_LE(evaluator.dirty_count(), objects.size());
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(incremental_evaluator_reuses_cells_of_permuted_objects)
+{
+    std::mt19937 rng{13};
+    const double threshold = 30;
+    ssr::incremental_evaluator evaluator{threshold};
+
+    // Small extent, so that there are boxes inside others
+    std::vector<detected_object> objects = ssr::test::random_scene(rng, 40, 300);
+    const std::size_t cells = objects.size() * (objects.size() - 1);
+    evaluator.evaluate(objects);
+    BOOST_CHECK_EQUAL(evaluator.reused_count(), 0);
+
+    for (unsigned int trial = 0; trial < 50; ++trial)
+    {
+        if (trial % 10 == 0)
+            std::reverse(objects.begin(), objects.end());
+        else
+            std::shuffle(objects.begin(), objects.end(), rng);
+
+        const ssr::ssr_matrix& incremental = evaluator.evaluate(objects);
+
+        BOOST_CHECK(incremental == evaluate_relations(objects, threshold));
+        BOOST_CHECK_EQUAL(evaluator.dirty_count(), 0);
+        BOOST_CHECK_EQUAL(evaluator.reused_count(), cells);
+    }
+
+    // Only the cells of a moved object are evaluated anew
+    objects.front().bounding_box.x0 += 10;
+    objects.front().bounding_box.x1 += 10;
+    std::shuffle(objects.begin(), objects.end(), rng);
+    BOOST_CHECK(evaluator.evaluate(objects) == evaluate_relations(objects, threshold));
+    BOOST_CHECK_EQUAL(evaluator.dirty_count(), 1);
+    BOOST_CHECK_EQUAL(evaluator.reused_count(), (objects.size() - 1) * (objects.size() - 2));
+}
+
+
+BOOST_AUTO_TEST_CASE(series_equals_frame_by_frame_evaluation)
+{
+    std::mt19937 rng{17};
+    const double threshold = 30;
+
+    std::vector<std::vector<detected_object>> frames;
+    ssr::object_series series;
+    for (unsigned int frame = 0; frame < 300; ++frame)
+    {
+        frames.push_back(ssr::test::random_scene(rng, rng() % 30, 1000));
+        series.add_frame(frames.back());
+    }
+
+    const std::vector<ssr::ssr_matrix> from_frames = evaluate_relations_series(frames, threshold, 4);
+    const std::vector<ssr::ssr_matrix> from_series = evaluate_relations_series(series, threshold, 4);
+
+    BOOST_REQUIRE_EQUAL(from_frames.size(), frames.size());
+    BOOST_REQUIRE_EQUAL(from_series.size(), frames.size());
+    for (std::size_t frame = 0; frame < frames.size(); ++frame)
+    {
+        const ssr::ssr_matrix expected = evaluate_relations(frames[frame], threshold);
+        BOOST_CHECK(from_frames[frame] == expected);
+        BOOST_CHECK(from_series[frame] == expected);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(threshold_sweep_equals_evaluation_per_threshold)
+{
+    std::mt19937 rng{23};
+    const std::vector<double> thresholds{0, 5, 15, 30, 45, 60, 120};
+
+    for (unsigned int dim : {0u, 1u, 2u, 5u, 40u})
+    {
+        for (unsigned int trial = 0; trial < 20; ++trial)
+        {
+            const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, 600);
+            const std::vector<ssr::ssr_matrix> sweep = evaluate_relations_thresholds(objects, thresholds);
+
+            BOOST_REQUIRE_EQUAL(sweep.size(), thresholds.size());
+            for (std::size_t k = 0; k < thresholds.size(); ++k)
+                BOOST_CHECK(sweep[k] == evaluate_relations(objects, thresholds[k]));
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(horizons_equal_evaluation_per_horizon)
+{
+    std::mt19937 rng{29};
+    const double threshold = 30;
+    const unsigned int horizon_count = 3;
+
+    for (unsigned int dim : {0u, 1u, 2u, 5u, 40u})
+    {
+        for (unsigned int trial = 0; trial < 20; ++trial)
+        {
+            // Draw each horizon as an independent past of the same current scene
+            std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, 600);
+            for (unsigned int horizon = 0; horizon < horizon_count; ++horizon)
+            {
+                std::vector<detected_object> past = ssr::test::random_scene(rng, dim, 600);
+                for (unsigned int i = 0; i < dim; ++i)
+                    objects[i].past_bounding_boxes.push_back(rng() % 2 == 0 ? past[i].past_bounding_box
+                                                                             : objects[i].bounding_box);
+            }
+
+            const std::vector<ssr::ssr_matrix> horizons = evaluate_dynamic_relations_horizons(objects, threshold);
+
+            BOOST_REQUIRE_EQUAL(horizons.size(), dim == 0 ? 0 : horizon_count);
+            for (std::size_t horizon = 0; horizon < horizons.size(); ++horizon)
+            {
+                std::vector<detected_object> at_horizon = objects;
+                for (detected_object& object : at_horizon)
+                    object.past_bounding_box = object.past_bounding_boxes[horizon];
+
+                const ssr::ssr_matrix expected = evaluate_relations(at_horizon, threshold);
+                BOOST_REQUIRE_EQUAL(horizons[horizon].dim(), expected.dim());
+                for (std::size_t i = 0; i < expected.dim(); ++i)
+                    for (std::size_t j = 0; j < expected.dim(); ++j)
+                        BOOST_CHECK_EQUAL(horizons[horizon](i, j).mask(),
+                                          expected(i, j).mask() & ssr::dynamic_relations_mask);
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(hand_centric_cells_equal_full_evaluation)
+{
+    std::mt19937 rng{31};
+    const double threshold = 30;
+
+    for (unsigned int dim : {0u, 1u, 2u, 5u, 60u})
+    {
+        for (unsigned int trial = 0; trial < 20; ++trial)
+        {
+            std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, 2000);
+            for (detected_object& object : objects)
+                object.class_name = rng() % 20 == 0 ? "LeftHand" : rng() % 20 == 0 ? "RightHand" : "cup";
+
+            const ssr::ssr_matrix expected = evaluate_relations(objects, threshold);
+
+            // Every pair is in the neighbourhood, so nothing may be missing
+            ssr::hand_centric_options everything;
+            everything.neighbourhood_distance = 1e9;
+            const ssr_sparse_cell_list all_cells = evaluate_relations_hand_centric(objects, threshold, everything);
+            const bool any_hand = std::any_of(objects.begin(), objects.end(), [](const detected_object& object)
+            {
+                return object.class_name != "cup";
+            });
+            if (any_hand)
+                BOOST_CHECK(unpack(all_cells, objects.size()) == expected);
+            else
+                BOOST_CHECK(all_cells.empty());
+
+            // Otherwise, all cells of the hands and only cells which exist
+            const ssr_sparse_cell_list cells = evaluate_relations_hand_centric(objects, threshold);
+            const auto by_position = [](const ssr_sparse_cell& a, const ssr_sparse_cell& b)
+            {
+                return std::make_pair(a.subject_index, a.object_index) < std::make_pair(b.subject_index,
+                                                                                         b.object_index);
+            };
+            BOOST_CHECK(std::is_sorted(cells.begin(), cells.end(), by_position));
+
+            const ssr::ssr_matrix unpacked = unpack(cells, objects.size());
+            for (std::size_t i = 0; i < objects.size(); ++i) for (std::size_t j = 0; j < objects.size(); ++j)
+            {
+                if (objects[i].class_name != "cup" or objects[j].class_name != "cup")
+                    BOOST_CHECK_EQUAL(unpacked(i, j).mask(), expected(i, j).mask());
+                else if (unpacked(i, j).mask() != 0)
+                    BOOST_CHECK_EQUAL(unpacked(i, j).mask(), expected(i, j).mask());
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(kernel_on_raw_buffers_equals_evaluate_relations)
+{
+    std::mt19937 rng{37};
+    const double threshold = 30;
+
+    for (unsigned int dim : {0u, 1u, 2u, 5u, 40u})
+    {
+        for (unsigned int trial = 0; trial < 20; ++trial)
+        {
+            std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, 600);
+
+            // Whole millimetres on every second trial, which are exact in float and double alike
+            if (trial % 2 == 1)
+            {
+                for (detected_object& object : objects)
+                {
+                    for (visionx::BoundingBox3D* bb : {&object.bounding_box, &object.past_bounding_box})
+                    {
+                        for (float* value : {&bb->x0, &bb->y0, &bb->z0, &bb->x1, &bb->y1, &bb->z1})
+                            *value = std::round(*value);
+                    }
+                }
+            }
+
+            const ssr::ssr_matrix expected = evaluate_relations(objects, threshold);
+
+            // Interleaved float buffers into raw masks
+            std::vector<float> interleaved;
+            std::vector<float> past_interleaved;
+            for (const detected_object& object : objects)
+            {
+                const visionx::BoundingBox3D& bb = object.bounding_box;
+                const visionx::BoundingBox3D& past_bb = object.past_bounding_box;
+                interleaved.insert(interleaved.end(), {bb.x0, bb.y0, bb.z0, bb.x1, bb.y1, bb.z1});
+                past_interleaved.insert(past_interleaved.end(), {past_bb.x0, past_bb.y0, past_bb.z0, past_bb.x1,
+                                                                 past_bb.y1, past_bb.z1});
+            }
+            std::vector<std::uint16_t> masks(dim * dim, 0);
+            ssr::kernel::evaluate_relations(ssr::kernel::interleaved_boxes<float>{interleaved.data(), dim},
+                                            ssr::kernel::interleaved_boxes<float>{past_interleaved.data(), dim},
+                                            threshold, masks.data());
+            for (std::size_t cell = 0; cell < masks.size(); ++cell)
+                BOOST_CHECK_EQUAL(masks[cell], expected.data()[cell].mask());
+
+            if (trial % 2 == 0)
+                continue;
+
+            // Structure-of-arrays in double precision
+            std::vector<std::vector<double>> current(6);
+            std::vector<std::vector<double>> past(6);
+            for (const detected_object& object : objects)
+            {
+                for (std::size_t k = 0; k < 6; ++k)
+                {
+                    current[k].push_back(interleaved[(&object - objects.data()) * 6 + k]);
+                    past[k].push_back(past_interleaved[(&object - objects.data()) * 6 + k]);
+                }
+            }
+            const ssr::kernel::soa_boxes<double> boxes{current[0].data(), current[1].data(), current[2].data(),
+                                                       current[3].data(), current[4].data(), current[5].data(), dim};
+            const ssr::kernel::soa_boxes<double> past_boxes{past[0].data(), past[1].data(), past[2].data(),
+                                                            past[3].data(), past[4].data(), past[5].data(), dim};
+            BOOST_CHECK(ssr::kernel::evaluate_relations(boxes, past_boxes, threshold) == expected);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(small_scene_equals_fused)
+{
+    std::mt19937 rng{41};
+    const double threshold = 30;
+
+    for (unsigned int trial = 0; trial < 500; ++trial)
+    {
+        const unsigned int dim = rng() % 80;
+        const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, trial % 2 == 0 ? 2000 : 200);
+
+        const ssr::ssr_matrix fused = evaluate_relations(objects, threshold, evaluation_strategy::fused);
+        BOOST_CHECK(evaluate_relations(objects, threshold, evaluation_strategy::small_scene) == fused);
+
+        // Cell access and raw masks of a fixed capacity
+        if (dim <= 32)
+        {
+            ssr::small_scene<32> scene;
+            scene.evaluate(ssr::kernel::project_boxes(objects, [](const detected_object& object) -> const auto&
+                           {
+                               return object.bounding_box;
+                           }),
+                           ssr::kernel::project_boxes(objects, [](const detected_object& object) -> const auto&
+                           {
+                               return object.past_bounding_box;
+                           }),
+                           threshold);
+
+            std::vector<std::uint16_t> masks(dim * dim, 0xffff);
+            scene.write(masks.data());
+            for (std::size_t i = 0; i < dim; ++i) for (std::size_t j = 0; j < dim; ++j)
+            {
+                BOOST_CHECK_EQUAL(scene(i, j).mask(), fused(i, j).mask());
+                BOOST_CHECK_EQUAL(masks[i * dim + j], fused(i, j).mask());
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(small_scene_rejects_too_many_objects)
+{
+    std::mt19937 rng{17};
+    const std::vector<detected_object> objects = ssr::test::random_scene(rng, 17);
+
+    const auto current_bounding_box = [](const detected_object& object) -> const auto&
+    {
+        return object.bounding_box;
+    };
+    const auto past_bounding_box = [](const detected_object& object) -> const auto&
+    {
+        return object.past_bounding_box;
+    };
+
+    ssr::small_scene<16> scene;
+    BOOST_CHECK_THROW(scene.evaluate(ssr::kernel::project_boxes(objects, current_bounding_box),
+                                     ssr::kernel::project_boxes(objects, past_bounding_box), 30),
+                      std::exception);
+
+    const std::vector<detected_object> fitting(objects.begin(), objects.begin() + 16);
+    scene.evaluate(ssr::kernel::project_boxes(fitting, current_bounding_box),
+                   ssr::kernel::project_boxes(fitting, past_bounding_box), 30);
+    BOOST_CHECK_EQUAL(scene.size(), 16);
+}
@@ -0,0 +1,169 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::ssr::evaluation_cache
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/ssr.h>
+#include <corcal/core/ssr/test/random_scene.h>
+
+
+using namespace corcal::core;
+
+
+BOOST_AUTO_TEST_CASE(cached_matrices_equal_evaluate_relations)
+{
+    std::mt19937 rng{42};
+    ssr::evaluation_cache cache{8, 0};
+
+    std::vector<std::vector<detected_object>> scenes;
+    for (std::size_t count = 0; count < 6; ++count)
+        scenes.push_back(ssr::test::random_scene(rng, count * 3));
+
+    // Each scene twice, the second time from the cache
+    for (int pass = 0; pass < 2; ++pass)
+        for (const std::vector<detected_object>& objects : scenes)
+            BOOST_CHECK(cache.evaluate(objects, 30) == ssr::evaluate_relations(objects, 30));
+
+    BOOST_CHECK_EQUAL(cache.misses(), scenes.size());
+    BOOST_CHECK_EQUAL(cache.hits(), scenes.size());
+    BOOST_CHECK_EQUAL(cache.size(), scenes.size());
+
+    // The threshold is part of the key
+    BOOST_CHECK(cache.evaluate(scenes[3], 10) == ssr::evaluate_relations(scenes[3], 10));
+    BOOST_CHECK_EQUAL(cache.misses(), scenes.size() + 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(quantisation_shares_nearly_identical_scenes)
+{
+    std::mt19937 rng{7};
+    const std::vector<detected_object> objects = ssr::test::random_scene(rng, 10);
+    ssr::evaluation_cache cache{4, 10};
+
+    const ssr::ssr_matrix expected = cache.evaluate(objects, 30);
+
+    // Moving a box by far less than the resolution keeps it in the same cell, unless it sits right on a boundary
+    std::vector<detected_object> jittered = objects;
+    jittered[0].bounding_box.x0 = 10 * std::round(jittered[0].bounding_box.x0 / 10) + 0.1f;
+    std::vector<detected_object> jittered_again = jittered;
+    jittered_again[0].bounding_box.x0 += 0.2f;
+
+    cache.evaluate(jittered, 30);
+    const std::size_t misses = cache.misses();
+    BOOST_CHECK(cache.evaluate(jittered_again, 30) == cache.evaluate(jittered, 30));
+    BOOST_CHECK_EQUAL(cache.misses(), misses);
+
+    // Moving it by more does not
+    jittered_again[0].bounding_box.x0 += 20;
+    cache.evaluate(jittered_again, 30);
+    BOOST_CHECK_EQUAL(cache.misses(), misses + 1);
+
+    BOOST_CHECK(cache.evaluate(objects, 30) == expected);
+}
+
+
+BOOST_AUTO_TEST_CASE(least_recently_used_scene_is_evicted)
+{
+    std::mt19937 rng{3};
+    const std::vector<detected_object> a = ssr::test::random_scene(rng, 4);
+    const std::vector<detected_object> b = ssr::test::random_scene(rng, 4);
+    const std::vector<detected_object> c = ssr::test::random_scene(rng, 4);
+    ssr::evaluation_cache cache{2, 1};
+
+    cache.evaluate(a, 30);
+    cache.evaluate(b, 30);
+    cache.evaluate(a, 30);  // b is now least recently used
+    cache.evaluate(c, 30);  // Evicts b
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+    BOOST_CHECK_EQUAL(cache.hits(), 1);
+    BOOST_CHECK_EQUAL(cache.misses(), 3);
+
+    cache.evaluate(a, 30);
+    cache.evaluate(c, 30);
+    BOOST_CHECK_EQUAL(cache.hits(), 3);
+
+    cache.evaluate(b, 30);
+    BOOST_CHECK_EQUAL(cache.misses(), 4);
+    BOOST_CHECK_EQUAL(cache.size(), 2);
+
+    cache.clear();
+    cache.reset_counters();
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK_EQUAL(cache.hits(), 0);
+    BOOST_CHECK_EQUAL(cache.misses(), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(eviction_survives_many_insertions)
+{
+    std::mt19937 rng{7};
+    std::vector<std::vector<detected_object>> scenes;
+    for (int i = 0; i < 300; ++i)
+        scenes.push_back(ssr::test::random_scene(rng, 3));
+    ssr::evaluation_cache cache{50, 1};
+
+    // Many more insertions than the capacity, each evicting through the recency list
+    for (const std::vector<detected_object>& scene : scenes)
+        cache.evaluate(scene, 30);
+    BOOST_CHECK_EQUAL(cache.size(), 50);
+    BOOST_CHECK_EQUAL(cache.misses(), scenes.size());
+
+    for (std::size_t i = scenes.size() - 50; i < scenes.size(); ++i)
+        BOOST_CHECK(cache.evaluate(scenes[i], 30) == ssr::evaluate_relations(scenes[i], 30));
+    BOOST_CHECK_EQUAL(cache.hits(), 50);
+
+    cache.clear();
+    for (const std::vector<detected_object>& scene : scenes)
+        cache.evaluate(scene, 30);
+    BOOST_CHECK_EQUAL(cache.size(), 50);
+}
+
+BOOST_AUTO_TEST_CASE(scenes_which_cannot_be_quantised_are_not_cached)
+{
+    std::mt19937 rng{5};
+    std::vector<detected_object> objects = ssr::test::random_scene(rng, 5);
+    objects[2].bounding_box.y1 = std::numeric_limits<float>::infinity();
+    ssr::evaluation_cache cache{4, 1};
+
+    for (int pass = 0; pass < 2; ++pass)
+        BOOST_CHECK(cache.evaluate(objects, 30) == ssr::evaluate_relations(objects, 30));
+    BOOST_CHECK_EQUAL(cache.size(), 0);
+    BOOST_CHECK_EQUAL(cache.hits(), 0);
+    BOOST_CHECK_EQUAL(cache.misses(), 2);
+
+    // Unless coordinates are taken as they are
+    ssr::evaluation_cache exact_cache{4, 0};
+    for (int pass = 0; pass < 2; ++pass)
+        BOOST_CHECK(exact_cache.evaluate(objects, 30) == ssr::evaluate_relations(objects, 30));
+    BOOST_CHECK_EQUAL(exact_cache.hits(), 1);
+}
@@ -0,0 +1,134 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::test::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::ssr::event_generator
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/ssr.h>
+#include <corcal/core/ssr/test/random_scene.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    using pair_state = std::map<std::pair<std::string, std::string>, int>;
+
+
+    pair_state
+    state_of(const std::vector<detected_object>& objects, const ssr::ssr_matrix& ssr_matrix)
+    {
+        pair_state state;
+        for (std::size_t i = 0; i < objects.size(); ++i) for (std::size_t j = 0; j < objects.size(); ++j)
+            if (ssr_matrix(i, j).mask() != 0)
+                state[{objects[i].instance_name, objects[j].instance_name}] = ssr_matrix(i, j).mask();
+        return state;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(events_replay_to_current_relations)
+{
+    std::mt19937 rng{5};
+    ssr::event_generator generator;
+
+    std::vector<detected_object> objects;
+    for (unsigned int i = 0; i < 13; ++i)
+        objects.push_back(ssr::test::random_object(rng, "object_" + std::to_string(i)));
+
+    pair_state replayed;
+    unsigned int next_name = 13;
+    for (unsigned int frame = 0; frame < 200; ++frame)
+    {
+        for (detected_object& object : objects)
+        {
+            object.past_bounding_box = object.bounding_box;
+            if (rng() % 4 == 0)
+            {
+                object.bounding_box.x0 += 40;
+                object.bounding_box.x1 += 40;
+            }
+        }
+        if (rng() % 4 == 0 and not objects.empty())
+            objects.erase(objects.begin() + rng() % objects.size());
+        if (rng() % 4 == 0)
+            objects.push_back(ssr::test::random_object(rng, "object_" + std::to_string(next_name++)));
+        if (rng() % 4 == 0)
+            std::shuffle(objects.begin(), objects.end(), rng);
+
+        const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30);
+        const std::vector<ssr_relation_event> events = generator.generate(objects, ssr_matrix, frame);
+
+        for (const ssr_relation_event& event : events)
+        {
+            BOOST_CHECK_EQUAL(event.timestamp, frame);
+
+            int& mask = replayed[{event.subject_instance_name, event.object_instance_name}];
+            const int bit = 1 << event.relation_id;
+
+            // Onsets only for inactive, offsets only for active relations
+            BOOST_CHECK_EQUAL((mask & bit) == 0, event.onset);
+            mask ^= bit;
+            if (mask == 0)
+                replayed.erase({event.subject_instance_name, event.object_instance_name});
+        }
+
+        BOOST_CHECK(replayed == ::state_of(objects, ssr_matrix));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(unchanged_frames_yield_no_events)
+{
+    std::mt19937 rng{7};
+    std::vector<detected_object> objects;
+    for (unsigned int i = 0; i < 10; ++i)
+        objects.push_back(ssr::test::random_object(rng, "object_" + std::to_string(i)));
+    const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30);
+
+    ssr::event_generator generator{mask_of(ssr::relation::contact)};
+    const std::vector<ssr_relation_event> onsets = generator.generate(objects, ssr_matrix, 0);
+    for (const ssr_relation_event& event : onsets)
+    {
+        BOOST_CHECK(event.onset);
+        BOOST_CHECK_EQUAL(event.relation_id, static_cast<int>(ssr::relation::contact));
+    }
+
+    // Reordering alone does not change any relation
+    std::vector<detected_object> reversed{objects.rbegin(), objects.rend()};
+    BOOST_CHECK(generator.generate(reversed, evaluate_relations(reversed, 30), 1).empty());
+
+    generator.reset();
+    BOOST_CHECK_EQUAL(generator.generate(objects, ssr_matrix, 2).size(), onsets.size());
+}
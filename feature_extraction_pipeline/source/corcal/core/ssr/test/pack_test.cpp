@@ -0,0 +1,91 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::test::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+
+#define BOOST_TEST_MODULE corcal::test::core::ssr::pack
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <random>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/ssr.h>
+#include <corcal/core/ssr/test/random_scene.h>
+
+
+using namespace corcal::core;
+
+
+BOOST_AUTO_TEST_CASE(unpack_inverts_pack)
+{
+    std::mt19937 rng{13};
+
+    for (unsigned int trial = 0; trial < 200; ++trial)
+    {
+        const unsigned int dim = rng() % 60;
+        const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, trial % 2 == 0 ? 5000 : 300);
+        const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30);
+
+        const ssr_matrix_packed plain = pack(ssr_matrix, false);
+        const ssr_matrix_packed run_length_encoded = pack(ssr_matrix, true);
+
+        BOOST_CHECK_EQUAL(plain.cells.size(), dim > 1 ? dim * (dim - 1) / 2 : 0);
+        BOOST_CHECK_LE(run_length_encoded.cells.size(), plain.cells.size());
+        BOOST_CHECK(unpack(plain) == ssr_matrix);
+        BOOST_CHECK(unpack(run_length_encoded) == ssr_matrix);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(evaluated_matrices_are_antisymmetric)
+{
+    std::mt19937 rng{19};
+
+    for (unsigned int trial = 0; trial < 100; ++trial)
+    {
+        const unsigned int dim = rng() % 80;
+        const std::vector<detected_object> objects = ssr::test::random_scene(rng, dim, trial % 2 == 0 ? 5000 : 300);
+
+        for (const evaluation_strategy strategy : {evaluation_strategy::fused, evaluation_strategy::three_pass,
+                                                   evaluation_strategy::batched, evaluation_strategy::small_scene,
+                                                   evaluation_strategy::sweep})
+        {
+            const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30, strategy);
+            for (std::size_t i = 0; i < dim; ++i) for (std::size_t j = i + 1; j < dim; ++j)
+                BOOST_CHECK_EQUAL(ssr_matrix(j, i).mask(), ssr_matrix(i, j).inverse().mask());
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(long_runs_of_empty_cells_are_split)
+{
+    // 300 objects without any relation yield 44850 empty cells, more than a single run word can hold
+    const ssr::ssr_matrix empty{300};
+    const ssr_matrix_packed packed = pack(empty, true);
+
+    BOOST_CHECK_EQUAL(packed.cells.size(), 2);
+    BOOST_CHECK(unpack(packed) == empty);
+}
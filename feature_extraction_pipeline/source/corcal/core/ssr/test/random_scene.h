@@ -0,0 +1,95 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// corcal
+#include <corcal/interface/data_structures.h>
+
+
+namespace corcal::core::ssr::test
+{
+
+
+/**
+ * @brief Generates an object at a random position within [0, extent) with random extents, which did not move
+ */
+inline detected_object
+random_object(std::mt19937& rng, const std::string& instance_name, float extent = 1000)
+{
+    std::uniform_real_distribution<float> position{0, extent};
+    std::uniform_real_distribution<float> size{1, 300};
+
+    detected_object object{};
+    object.instance_name = instance_name;
+
+    visionx::BoundingBox3D& bb = object.bounding_box;
+    bb.x0 = position(rng);
+    bb.y0 = position(rng);
+    bb.z0 = position(rng);
+    bb.x1 = bb.x0 + size(rng);
+    bb.y1 = bb.y0 + size(rng);
+    bb.z1 = bb.z0 + size(rng);
+
+    object.past_bounding_box = bb;
+    return object;
+}
+
+
+/**
+ * @brief Generates a random scene of dim objects named "object_<i>", where roughly every second object moved
+ */
+inline std::vector<detected_object>
+random_scene(std::mt19937& rng, unsigned int dim, float extent = 1000)
+{
+    std::uniform_real_distribution<float> motion{-60, 60};
+
+    std::vector<detected_object> objects;
+    objects.reserve(dim);
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+        detected_object object = random_object(rng, "object_" + std::to_string(i), extent);
+
+        if (rng() % 2 == 0)
+        {
+            const float dx = motion(rng);
+            object.past_bounding_box.x0 += dx;
+            object.past_bounding_box.x1 += dx;
+            object.past_bounding_box.z0 += motion(rng);
+        }
+
+        objects.push_back(std::move(object));
+    }
+
+    return objects;
+}
+
+
+}
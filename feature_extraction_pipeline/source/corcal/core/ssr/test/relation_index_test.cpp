@@ -0,0 +1,168 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::test::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::ssr::relation_index
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/ssr.h>
+#include <corcal/core/ssr/test/random_scene.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    using pair_set = std::set<std::pair<std::string, std::string>>;
+
+
+    /**
+     * Checks all queries of the index against a full scan of the SSR matrix
+     */
+    void
+    check_against_scan(const ssr::relation_index& index, const std::vector<detected_object>& objects,
+                       const ssr::ssr_matrix& ssr_matrix)
+    {
+        BOOST_CHECK_EQUAL(index.size(), objects.size());
+
+        for (const ssr::relation_schema_entry& entry : ssr::relation_schema)
+        {
+            pair_set expected;
+            for (std::size_t i = 0; i < objects.size(); ++i) for (std::size_t j = 0; j < objects.size(); ++j)
+                if (i != j and ssr_matrix(i, j).test(entry.id))
+                    expected.emplace(objects[i].instance_name, objects[j].instance_name);
+
+            const std::vector<ssr::relation_index::instance_pair> pairs = index.pairs(entry.id);
+            BOOST_CHECK_EQUAL(index.count(entry.id), expected.size());
+            BOOST_CHECK(pair_set(pairs.begin(), pairs.end()) == expected);
+        }
+
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            BOOST_CHECK(index.contains(objects[i].instance_name));
+
+            std::size_t non_empty = 0;
+            for (std::size_t j = 0; j < objects.size(); ++j)
+            {
+                if (i == j) continue;
+                BOOST_CHECK_EQUAL(index.between(objects[i].instance_name, objects[j].instance_name).mask(),
+                                  ssr_matrix(i, j).mask());
+                if (ssr_matrix(i, j).mask() != 0)
+                    ++non_empty;
+            }
+            BOOST_CHECK_EQUAL(index.row(objects[i].instance_name).size(), non_empty);
+
+            for (const ssr::relation_schema_entry& entry : ssr::relation_schema)
+            {
+                std::set<std::string> expected;
+                for (std::size_t j = 0; j < objects.size(); ++j)
+                    if (i != j and ssr_matrix(i, j).test(entry.id))
+                        expected.insert(objects[j].instance_name);
+
+                const std::vector<std::string>& related = index.objects_of(objects[i].instance_name, entry.id);
+                BOOST_CHECK_EQUAL(related.size(), expected.size());
+                BOOST_CHECK(std::set<std::string>(related.begin(), related.end()) == expected);
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(queries_equal_scan_of_current_matrix)
+{
+    std::mt19937 rng{11};
+    ssr::relation_index index;
+
+    std::vector<detected_object> objects;
+    for (unsigned int i = 0; i < 13; ++i)
+        objects.push_back(ssr::test::random_object(rng, "object_" + std::to_string(i)));
+
+    std::vector<std::string> removed;
+    unsigned int next_name = 13;
+    for (unsigned int frame = 0; frame < 150; ++frame)
+    {
+        for (detected_object& object : objects)
+        {
+            object.past_bounding_box = object.bounding_box;
+            if (rng() % 4 == 0)
+            {
+                object.bounding_box.x0 += 40;
+                object.bounding_box.x1 += 40;
+            }
+        }
+        if (rng() % 4 == 0 and not objects.empty())
+        {
+            const std::size_t erased = rng() % objects.size();
+            removed.push_back(objects[erased].instance_name);
+            objects.erase(objects.begin() + erased);
+        }
+        if (rng() % 4 == 0)
+            objects.push_back(ssr::test::random_object(rng, "object_" + std::to_string(next_name++)));
+        if (rng() % 4 == 0)
+            std::shuffle(objects.begin(), objects.end(), rng);
+
+        const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30);
+        index.update(objects, ssr_matrix);
+
+        ::check_against_scan(index, objects, ssr_matrix);
+        for (const std::string& instance_name : removed)
+        {
+            BOOST_CHECK(not index.contains(instance_name));
+            BOOST_CHECK(index.row(instance_name).empty());
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(clear_forgets_everything)
+{
+    std::mt19937 rng{12};
+    ssr::relation_index index;
+
+    std::vector<detected_object> objects;
+    for (unsigned int i = 0; i < 8; ++i)
+        objects.push_back(ssr::test::random_object(rng, "object_" + std::to_string(i)));
+
+    index.update(objects, evaluate_relations(objects, 30));
+    index.clear();
+
+    BOOST_CHECK_EQUAL(index.size(), 0);
+    for (const ssr::relation_schema_entry& entry : ssr::relation_schema)
+        BOOST_CHECK_EQUAL(index.count(entry.id), 0);
+    for (const detected_object& object : objects)
+        BOOST_CHECK(not index.contains(object.instance_name));
+
+    const ssr::ssr_matrix ssr_matrix = evaluate_relations(objects, 30);
+    index.update(objects, ssr_matrix);
+    ::check_against_scan(index, objects, ssr_matrix);
+}
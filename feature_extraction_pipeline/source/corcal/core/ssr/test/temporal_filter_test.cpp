@@ -0,0 +1,196 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::test::core::ssr
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::ssr::temporal_filter
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <algorithm>
+#include <random>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/ssr.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    detected_object
+    object_named(const std::string& instance_name)
+    {
+        detected_object object{};
+        object.instance_name = instance_name;
+        return object;
+    }
+
+
+    /**
+     * Per cell reference of the temporal filter, keyed by instance names
+     */
+    class reference_filter
+    {
+
+        private:
+
+            std::size_t m_window;
+            std::size_t m_on_count;
+            std::size_t m_off_count;
+            std::map<std::pair<std::string, std::string>, std::vector<std::uint16_t>> m_history;
+            std::map<std::pair<std::string, std::string>, std::uint16_t> m_output;
+
+        public:
+
+            reference_filter(std::size_t window, std::size_t on_count, std::size_t off_count) :
+                m_window{window}, m_on_count{on_count}, m_off_count{off_count}
+            {
+                // pass
+            }
+
+            ssr::ssr_matrix filter(const std::vector<detected_object>& objects, const ssr::ssr_matrix& ssr_matrix)
+            {
+                // Forget pairs of disappeared objects
+                std::map<std::pair<std::string, std::string>, std::vector<std::uint16_t>> history;
+                std::map<std::pair<std::string, std::string>, std::uint16_t> output;
+                ssr::ssr_matrix filtered{objects.size()};
+
+                for (std::size_t i = 0; i < objects.size(); ++i) for (std::size_t j = 0; j < objects.size(); ++j)
+                {
+                    const std::pair<std::string, std::string> pair{objects[i].instance_name,
+                                                                   objects[j].instance_name};
+                    std::vector<std::uint16_t>& frames = history[pair] = m_history[pair];
+                    frames.push_back(ssr_matrix(i, j).mask());
+                    if (frames.size() > m_window)
+                        frames.erase(frames.begin());
+
+                    std::uint16_t mask = m_output[pair];
+                    for (unsigned int bit = 0; bit < 16; ++bit)
+                    {
+                        std::size_t count = 0;
+                        for (const std::uint16_t frame : frames)
+                            count += (frame >> bit) & 1;
+
+                        if (count >= m_on_count)
+                            mask = static_cast<std::uint16_t>(mask | (1u << bit));
+                        else if (count <= m_off_count)
+                            mask = static_cast<std::uint16_t>(mask & ~(1u << bit));
+                    }
+                    output[pair] = mask;
+                    filtered(i, j) = relations{mask};
+                }
+
+                m_history = std::move(history);
+                m_output = std::move(output);
+                return filtered;
+            }
+
+    };
+
+
+    void
+    check_against_reference(std::size_t window, std::size_t on_count, std::size_t off_count, unsigned int seed)
+    {
+        std::mt19937 rng{seed};
+        ssr::temporal_filter filter{window, on_count, off_count};
+        reference_filter reference{window, on_count, off_count};
+
+        std::vector<detected_object> objects;
+        for (unsigned int i = 0; i < 9; ++i)
+            objects.push_back(::object_named("object_" + std::to_string(i)));
+
+        unsigned int next_name = 9;
+        for (unsigned int frame = 0; frame < 300; ++frame)
+        {
+            if (rng() % 8 == 0 and not objects.empty())
+                objects.erase(objects.begin() + rng() % objects.size());
+            if (rng() % 8 == 0)
+                objects.push_back(::object_named("object_" + std::to_string(next_name++)));
+            if (rng() % 8 == 0)
+                std::shuffle(objects.begin(), objects.end(), rng);
+
+            // Flickering relations, each bit of each cell active with a probability depending on the cell
+            ssr::ssr_matrix ssr_matrix{objects.size()};
+            for (std::size_t i = 0; i < objects.size(); ++i) for (std::size_t j = 0; j < objects.size(); ++j)
+            {
+                if (i == j) continue;
+                const unsigned int probability = (std::hash<std::string>{}(objects[i].instance_name
+                                                                           + objects[j].instance_name) % 5) * 25;
+                for (const ssr::relation_schema_entry& entry : ssr::relation_schema)
+                    ssr_matrix(i, j).set(entry.id, rng() % 100 < probability);
+            }
+
+            const ssr::ssr_matrix expected = reference.filter(objects, ssr_matrix);
+            const ssr::ssr_matrix filtered = filter.filter(objects, ssr_matrix);
+            BOOST_CHECK(filtered == expected);
+
+            std::size_t suppressed = 0;
+            for (std::size_t cell = 0; cell < ssr_matrix.size(); ++cell)
+                suppressed += static_cast<std::size_t>(
+                    __builtin_popcount(ssr_matrix.data()[cell].mask() ^ expected.data()[cell].mask()));
+            BOOST_CHECK_EQUAL(filter.suppressed_count(), suppressed);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(majority_equals_reference)
+{
+    for (const std::size_t window : {1, 2, 5, 8})
+        ::check_against_reference(window, window / 2 + 1, window / 2, static_cast<unsigned int>(window));
+}
+
+
+BOOST_AUTO_TEST_CASE(hysteresis_equals_reference)
+{
+    for (const std::size_t window : {2, 3, 7})
+        ::check_against_reference(window, window, 0, static_cast<unsigned int>(window) + 100);
+    ::check_against_reference(9, 6, 2, 200);
+}
+
+
+BOOST_AUTO_TEST_CASE(majority_removes_single_frame_flicker)
+{
+    const std::vector<detected_object> objects{::object_named("left_hand"), ::object_named("cup")};
+    ssr::temporal_filter filter = ssr::temporal_filter::majority(3);
+
+    ssr::ssr_matrix contact{2};
+    contact(0, 1).contact(true);
+    contact(1, 0).contact(true);
+    const ssr::ssr_matrix none{2};
+
+    filter.filter(objects, contact);
+    filter.filter(objects, contact);
+    BOOST_CHECK(filter.filter(objects, contact) == contact);
+    BOOST_CHECK(filter.filter(objects, none) == contact);
+    BOOST_CHECK_EQUAL(filter.suppressed_count(), 2);
+    BOOST_CHECK(filter.filter(objects, contact) == contact);
+
+    filter.reset();
+    BOOST_CHECK(filter.filter(objects, contact) == none);
+}
@@ -24,9 +24,14 @@
 #pragma once
 
 
+#include <corcal/core/vwm/assignment.h>
+#include <corcal/core/vwm/bounding_box_smoother.h>
+#include <corcal/core/vwm/class_registry.h>
 #include <corcal/core/vwm/observation.h>
+#include <corcal/core/vwm/observation_pool.h>
 #include <corcal/core/vwm/known_object.h>
 #include <corcal/core/vwm/memory.h>
+#include <corcal/core/vwm/spatial_grid.h>
 
 
 namespace corcal
@@ -0,0 +1,171 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/vwm/assignment.h>
+
+
+// STD/STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+
+std::vector<int>
+corcal::core::vwm::solve_assignment(const std::vector<double>& costs, std::size_t rows, std::size_t cols)
+{
+    ARMARX_CHECK_EQUAL(costs.size(), rows * cols);
+
+    std::vector<int> assignment(rows, -1);
+
+    // The method below assigns every row, hence the smaller side must be the rows
+    const bool transposed = rows > cols;
+    const std::size_t n = transposed ? cols : rows;
+    const std::size_t m = transposed ? rows : cols;
+    const auto cost = [&](std::size_t i, std::size_t j)
+    {
+        return transposed ? costs[j * cols + i] : costs[i * cols + j];
+    };
+
+    if (n == 0)
+        return assignment;
+
+    // Forbidden pairs get a cost higher than any n allowed pairs together, so that assigning one more allowed pair
+    // always pays off.  They are dropped from the result afterwards
+    double max_allowed = 0;
+    bool any_allowed = false;
+    for (const double c : costs)
+    {
+        ARMARX_CHECK_EXPRESSION_W_HINT(c >= 0, "Assignment costs must not be negative or NaN");
+        if (std::isfinite(c))
+        {
+            max_allowed = std::max(max_allowed, c);
+            any_allowed = true;
+        }
+    }
+
+    if (not any_allowed)
+        return assignment;
+
+    // A single row or column, as for most classes in a scene, only needs the cheapest allowed pair
+    if (n == 1)
+    {
+        std::size_t best = 0;
+        for (std::size_t j = 1; j < m; ++j)
+            if (cost(0, j) < cost(0, best))
+                best = j;
+
+        if (transposed)
+            assignment[best] = 0;
+        else
+            assignment[0] = static_cast<int>(best);
+        return assignment;
+    }
+
+    const double forbidden = (max_allowed + 1) * static_cast<double>(n + 1);
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // Shortest augmenting paths with potentials u (rows) and v (columns).  Index 0 is a virtual column, rows and
+    // columns are 1-based.  p[j] is the row assigned to column j
+    std::vector<double> u(n + 1, 0);
+    std::vector<double> v(m + 1, 0);
+    std::vector<std::size_t> p(m + 1, 0);
+    std::vector<std::size_t> way(m + 1, 0);
+    std::vector<double> min_slack(m + 1);
+    std::vector<bool> used(m + 1);
+
+    for (std::size_t i = 1; i <= n; ++i)
+    {
+        p[0] = i;
+        std::size_t j0 = 0;
+        std::fill(min_slack.begin(), min_slack.end(), infinity);
+        std::fill(used.begin(), used.end(), false);
+
+        do
+        {
+            used[j0] = true;
+            const std::size_t i0 = p[j0];
+            double delta = infinity;
+            std::size_t j1 = 0;
+
+            for (std::size_t j = 1; j <= m; ++j)
+            {
+                if (used[j])
+                    continue;
+
+                const double c = cost(i0 - 1, j - 1);
+                const double slack = (std::isfinite(c) ? c : forbidden) - u[i0] - v[j];
+                if (slack < min_slack[j])
+                {
+                    min_slack[j] = slack;
+                    way[j] = j0;
+                }
+                if (min_slack[j] < delta)
+                {
+                    delta = min_slack[j];
+                    j1 = j;
+                }
+            }
+
+            for (std::size_t j = 0; j <= m; ++j)
+            {
+                if (used[j])
+                {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                }
+                else
+                {
+                    min_slack[j] -= delta;
+                }
+            }
+
+            j0 = j1;
+        }
+        while (p[j0] != 0);
+
+        // Flip the augmenting path
+        do
+        {
+            const std::size_t j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        }
+        while (j0 != 0);
+    }
+
+    for (std::size_t j = 1; j <= m; ++j)
+    {
+        if (p[j] == 0 or not std::isfinite(cost(p[j] - 1, j - 1)))
+            continue;
+
+        if (transposed)
+            assignment[j - 1] = static_cast<int>(p[j] - 1);
+        else
+            assignment[p[j] - 1] = static_cast<int>(j - 1);
+    }
+
+    return assignment;
+}
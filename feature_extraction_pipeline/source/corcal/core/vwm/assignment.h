@@ -0,0 +1,50 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <vector>
+
+
+namespace corcal { namespace core { namespace vwm
+{
+
+
+/**
+ * @brief Solves the rectangular linear assignment problem with the Hungarian method, in O(n² m) for n <= m
+ *
+ * Assigns each row at most one column and each column at most one row, such that as many rows as possible are
+ * assigned, and among all such assignments the sum of the costs is minimal.  Pairs with infinite cost are never
+ * assigned.
+ *
+ * @param costs Row-major rows × cols costs, which must not be negative or NaN
+ * @return Column assigned to each row, or -1 if the row is not assigned
+ */
+std::vector<int>
+solve_assignment(const std::vector<double>& costs, std::size_t rows, std::size_t cols);
+
+
+}}}
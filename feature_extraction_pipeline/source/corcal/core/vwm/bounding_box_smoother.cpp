@@ -0,0 +1,114 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/vwm/bounding_box_smoother.h>
+
+
+// STD/STL
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+
+using namespace corcal::core::vwm;
+
+
+void
+bounding_box_sums::add(double w, const visionx::BoundingBox3D& bounding_box)
+{
+    const std::array<double, coordinates> box{bounding_box.x0, bounding_box.x1, bounding_box.y0, bounding_box.y1,
+                                              bounding_box.z0, bounding_box.z1};
+    weight += w;
+    for (std::size_t i = 0; i < coordinates; ++i)
+        coordinate[i] += w * box[i];
+}
+
+
+void
+bounding_box_sums::scale(double factor)
+{
+    weight *= factor;
+    for (double& sum : coordinate)
+        sum *= factor;
+}
+
+
+visionx::BoundingBox3D
+bounding_box_sums::mean() const
+{
+    ARMARX_CHECK_GREATER(weight, 0);
+
+    const double normalisation = 1. / weight;
+    visionx::BoundingBox3D mean;
+    mean.x0 = static_cast<float>(coordinate[0] * normalisation);
+    mean.x1 = static_cast<float>(coordinate[1] * normalisation);
+    mean.y0 = static_cast<float>(coordinate[2] * normalisation);
+    mean.y1 = static_cast<float>(coordinate[3] * normalisation);
+    mean.z0 = static_cast<float>(coordinate[4] * normalisation);
+    mean.z1 = static_cast<float>(coordinate[5] * normalisation);
+    return mean;
+}
+
+
+bounding_box_smoother::bounding_box_smoother(std::chrono::milliseconds window, smoothing_kernel kernel) :
+    m_window{window},
+    m_kernel{kernel}
+{
+    ARMARX_CHECK_GREATER(m_window.count(), 0);
+
+    // 3*sigma = window.  The normalisation of the Gaussian is left out, it cancels out in the weighted mean
+    const double sigma = static_cast<double>(m_window.count()) / 3;
+    m_weights.resize(static_cast<std::size_t>(m_window.count()) + 1);
+    for (std::size_t age = 0; age < m_weights.size(); ++age)
+    {
+        const double x = static_cast<double>(age);
+        m_weights[age] = std::exp(-x * x / (2 * sigma * sigma));
+    }
+
+    // Time constant window / 3, so that a bounding box as old as the window is weighted e^-3 ≈ 5%
+    m_decay_rate = 3. / static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(m_window).count());
+}
+
+
+std::chrono::milliseconds
+bounding_box_smoother::window() const
+{
+    return m_window;
+}
+
+
+smoothing_kernel
+bounding_box_smoother::kernel() const
+{
+    return m_kernel;
+}
+
+
+double
+bounding_box_smoother::decay(std::chrono::microseconds duration) const
+{
+    return std::exp(-static_cast<double>(duration.count()) * m_decay_rate);
+}
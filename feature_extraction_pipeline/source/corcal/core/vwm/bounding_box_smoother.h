@@ -0,0 +1,136 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// VisionX
+#include <VisionX/interface/core/DataTypes.h>
+
+
+namespace corcal { namespace core { namespace vwm
+{
+
+
+/**
+ * @brief Kernel weighting the past bounding boxes of a known object by their age
+ */
+enum class smoothing_kernel
+{
+    /**
+     * @brief Gaussian over the age with 3σ = window.  Bounding boxes older than the window are ignored
+     */
+    gaussian,
+
+    /**
+     * @brief Exponential decay with time constant window / 3, kept as running sums which are updated recursively
+     */
+    exponential
+};
+
+
+/**
+ * @brief Weighted running sums of bounding boxes, that is the sum of the weights and of each weighted coordinate
+ */
+struct bounding_box_sums
+{
+    static constexpr std::size_t coordinates = 6;
+
+    double weight = 0;
+    std::array<double, coordinates> coordinate{};
+
+    /**
+     * @brief Adds the bounding box with weight w
+     */
+    void add(double w, const visionx::BoundingBox3D& bounding_box);
+
+    /**
+     * @brief Multiplies all sums by factor
+     */
+    void scale(double factor);
+
+    /**
+     * @brief Weighted mean of the added bounding boxes.  Requires a positive weight
+     */
+    visionx::BoundingBox3D mean() const;
+};
+
+
+/**
+ * @brief Precomputed smoothing kernel for known_object::average_bounding_boxes
+ *
+ * The Gaussian weights are tabulated by the age quantised to milliseconds, so that smoothing does not evaluate any
+ * exponential.  Since the Gaussian weight of a bounding box changes with its age, its sums are accumulated over the
+ * window on each smoothing.  The exponential kernel decays all past bounding boxes by the same factor instead, so its
+ * sums are carried over from one smoothing to the next and only the bounding boxes added since are accumulated.
+ */
+class bounding_box_smoother
+{
+
+    private:
+
+        std::chrono::milliseconds m_window;
+        smoothing_kernel m_kernel;
+
+        /**
+         * @brief Gaussian weights by age in [ms], from 0 up to and including the window
+         */
+        std::vector<double> m_weights;
+
+        /**
+         * @brief Decay rate of the exponential kernel in [1/µs]
+         */
+        double m_decay_rate;
+
+    public:
+
+        bounding_box_smoother(std::chrono::milliseconds window, smoothing_kernel kernel = smoothing_kernel::gaussian);
+
+        std::chrono::milliseconds window() const;
+
+        smoothing_kernel kernel() const;
+
+        /**
+         * @brief Gaussian weight of a bounding box of the given age, 0 outside of the window
+         */
+        double weight(std::chrono::milliseconds age) const
+        {
+            const std::size_t index = static_cast<std::size_t>(age.count() < 0 ? -age.count() : age.count());
+            return index < m_weights.size() ? m_weights[index] : 0;
+        }
+
+        /**
+         * @brief Factor by which the exponential kernel decays the weights over the given duration
+         */
+        double decay(std::chrono::microseconds duration) const;
+
+};
+
+
+}}}
@@ -25,6 +25,7 @@
 
 
 // STD/STL
+#include <stdexcept>
 #include <string>
 
 
@@ -48,14 +49,28 @@ candidate::certainty(float value)
 const std::string&
 candidate::class_name() const
 {
-    return m_class_name;
+    return class_registry::global().name(m_class_id);
 }
 
 
 void
 candidate::class_name(const std::string& value)
 {
-    m_class_name = value;
+    m_class_id = class_registry::global().intern(value);
+}
+
+
+corcal::core::vwm::class_id
+candidate::class_id() const
+{
+    return m_class_id;
+}
+
+
+void
+candidate::class_id(vwm::class_id value)
+{
+    m_class_id = value;
 }
 
 
@@ -85,3 +100,110 @@ candidate::colour(const armarx::DrawColor24Bit& value)
 {
     m_colour = value;
 }
+
+
+candidate_list::candidate_list() :
+    m_size{0}
+{
+    // pass
+}
+
+
+candidate_list::candidate_list(std::initializer_list<candidate> candidates) :
+    m_size{0}
+{
+    for (const candidate& candidate : candidates)
+        push_back(candidate);
+}
+
+
+std::size_t
+candidate_list::size() const
+{
+    return m_size;
+}
+
+
+bool
+candidate_list::empty() const
+{
+    return m_size == 0;
+}
+
+
+void
+candidate_list::clear()
+{
+    m_size = 0;
+}
+
+
+bool
+candidate_list::push_back(const candidate& value)
+{
+    if (m_size == max_candidates)
+        return false;
+
+    m_candidates[m_size++] = value;
+    return true;
+}
+
+
+candidate&
+candidate_list::at(std::size_t index)
+{
+    if (index >= m_size)
+        throw std::out_of_range{"candidate_list index " + std::to_string(index) + " out of range"};
+    return m_candidates[index];
+}
+
+
+const candidate&
+candidate_list::at(std::size_t index) const
+{
+    if (index >= m_size)
+        throw std::out_of_range{"candidate_list index " + std::to_string(index) + " out of range"};
+    return m_candidates[index];
+}
+
+
+candidate&
+candidate_list::operator[](std::size_t index)
+{
+    return m_candidates[index];
+}
+
+
+const candidate&
+candidate_list::operator[](std::size_t index) const
+{
+    return m_candidates[index];
+}
+
+
+candidate_list::iterator
+candidate_list::begin()
+{
+    return m_candidates.data();
+}
+
+
+candidate_list::iterator
+candidate_list::end()
+{
+    return m_candidates.data() + m_size;
+}
+
+
+candidate_list::const_iterator
+candidate_list::begin() const
+{
+    return m_candidates.data();
+}
+
+
+candidate_list::const_iterator
+candidate_list::end() const
+{
+    return m_candidates.data() + m_size;
+}
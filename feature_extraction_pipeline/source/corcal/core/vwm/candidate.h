@@ -25,11 +25,17 @@
 
 
 // STD/STL
+#include <array>
+#include <cstddef>
+#include <initializer_list>
 #include <string>
 
 // RobotAPI
 #include <RobotAPI/interface/visualization/DebugDrawerInterface.h>
 
+// corcal
+#include <corcal/core/vwm/class_registry.h>
+
 
 namespace corcal { namespace core { namespace vwm
 {
@@ -41,7 +47,7 @@ class candidate
     private:
 
         float m_certainty;
-        std::string m_class_name;
+        vwm::class_id m_class_id = class_registry::no_class;
         int m_class_index;
         armarx::DrawColor24Bit m_colour;
 
@@ -49,8 +55,20 @@ class candidate
 
         float certainty() const;
         void certainty(float value);
+
+        /**
+         * @brief Name of the class, looked up in the global class_registry
+         */
         const std::string& class_name() const;
+
+        /**
+         * @brief Sets the class by name, interning it in the global class_registry
+         */
         void class_name(const std::string& value);
+
+        vwm::class_id class_id() const;
+        void class_id(vwm::class_id value);
+
         int class_index() const;
         void class_index(int value);
         const armarx::DrawColor24Bit& colour() const;
@@ -59,4 +77,54 @@ class candidate
 };
 
 
+/**
+ * @brief Candidates of an observation, stored inline up to max_candidates
+ *
+ * Candidates keep their storage when the list is cleared and refilled, and their class names are interned, so that
+ * refilling the list of a recycled observation does not allocate.  Candidates beyond max_candidates are dropped.
+ */
+class candidate_list
+{
+
+    public:
+
+        static constexpr std::size_t max_candidates = 8;
+
+        using iterator = candidate*;
+        using const_iterator = const candidate*;
+
+    private:
+
+        std::array<candidate, max_candidates> m_candidates;
+        std::size_t m_size;
+
+    public:
+
+        candidate_list();
+        candidate_list(std::initializer_list<candidate> candidates);
+
+        std::size_t size() const;
+        bool empty() const;
+        void clear();
+
+        /**
+         * @brief Appends a copy of the candidate, unless the list is full
+         * @return Whether the candidate was appended
+         */
+        bool push_back(const candidate& value);
+
+        candidate& at(std::size_t index);
+        const candidate& at(std::size_t index) const;
+
+        candidate& operator[](std::size_t index);
+        const candidate& operator[](std::size_t index) const;
+
+        iterator begin();
+        iterator end();
+        const_iterator begin() const;
+        const_iterator end() const;
+
+};
+
+
 }}}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/vwm/class_registry.h>
+
+
+// STD/STL
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+
+using namespace corcal::core::vwm;
+
+
+class_registry::class_registry()
+{
+    const class_id empty = intern("");
+    ARMARX_CHECK_EQUAL(empty, no_class);
+}
+
+
+class_registry&
+class_registry::global()
+{
+    static class_registry registry;
+    return registry;
+}
+
+
+class_id
+class_registry::intern(std::string_view name)
+{
+    const std::lock_guard<std::mutex> lock{m_mutex};
+
+    const auto it = m_ids.find(name);
+    if (it != std::end(m_ids))
+        return it->second;
+
+    const class_id id = static_cast<class_id>(m_names.size());
+    m_names.emplace_back(name);
+    m_ids.emplace(m_names.back(), id);
+    return id;
+}
+
+
+const std::string&
+class_registry::name(class_id id) const
+{
+    const std::lock_guard<std::mutex> lock{m_mutex};
+
+    ARMARX_CHECK_LESS(id, m_names.size());
+
+    return m_names[id];
+}
+
+
+std::size_t
+class_registry::size() const
+{
+    const std::lock_guard<std::mutex> lock{m_mutex};
+
+    return m_names.size();
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace corcal { namespace core { namespace vwm
+{
+
+
+/**
+ * @brief Dense integer id of an interned class name
+ */
+using class_id = std::uint32_t;
+
+
+/**
+ * @brief Registry interning class names into dense ids, in the order they are first seen
+ *
+ * Class names are interned once when observations are made, so that matching and tracking compare integers, and names
+ * are only looked up again when results are converted to interface types.  Ids are never reused and names are never
+ * moved, so references returned by name() stay valid for the lifetime of the registry.  Thread-safe.
+ */
+class class_registry
+{
+
+    public:
+
+        /**
+         * @brief Id of the empty class name, which is registered from the start
+         */
+        static constexpr class_id no_class = 0;
+
+    private:
+
+        /**
+         * @brief Names by id.  A deque, so that the names do not move when new ones are added
+         */
+        std::deque<std::string> m_names;
+
+        /**
+         * @brief Ids by name, viewing into m_names
+         */
+        std::unordered_map<std::string_view, class_id> m_ids;
+
+        mutable std::mutex m_mutex;
+
+    public:
+
+        class_registry();
+
+        class_registry(const class_registry&) = delete;
+        class_registry& operator=(const class_registry&) = delete;
+
+        /**
+         * @brief Registry shared by all vwm types
+         */
+        static class_registry& global();
+
+        /**
+         * @brief Id of the class name, registering it if it is new
+         */
+        class_id intern(std::string_view name);
+
+        /**
+         * @brief Name of the class with the given id
+         */
+        const std::string& name(class_id id) const;
+
+        /**
+         * @brief Number of registered class names, that is one more than the biggest id
+         */
+        std::size_t size() const;
+
+};
+
+
+}}}
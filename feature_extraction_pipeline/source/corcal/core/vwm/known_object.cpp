@@ -26,12 +26,11 @@
 
 // STD/STL
 #include <chrono>
-#include <cmath>
-#include <deque>
 #include <limits> // for numeric_limits
 #include <memory>
 #include <string>
-#include <tuple>
+#include <utility>
+#include <vector>
 
 // ArmarX
 #include <ArmarXCore/core/exceptions/local/ExpressionException.h>
@@ -48,13 +47,13 @@ known_object::known_object()
 
 known_object::known_object(observation::ptr initial_observation,unsigned int id)
 {
-    m_class_name = initial_observation->candidates().at(0).class_name();
-    m_id = m_class_name + "_" + std::to_string(id);
-    m_observations.push_back(initial_observation);
+    m_class_id = initial_observation->candidates().at(0).class_id();
+    m_id = class_name() + "_" + std::to_string(id);
+    remember_observation(initial_observation);
     m_last_zmin = std::numeric_limits<float>::quiet_NaN();
     m_last_zmax = std::numeric_limits<float>::quiet_NaN();
 
-    ARMARX_CHECK_EQUAL(m_observations.size(), 1);
+    ARMARX_CHECK_EQUAL(m_size, 1);
 }
 
 
@@ -96,32 +95,70 @@ known_object::id() const
 const std::string&
 known_object::class_name() const
 {
-    return m_class_name;
+    return class_registry::global().name(m_class_id);
+}
+
+
+corcal::core::vwm::class_id
+known_object::class_id() const
+{
+    return m_class_id;
 }
 
 
 observation::ptr
 known_object::current_observation() const
 {
-    ARMARX_CHECK_GREATER(m_observations.size(), 0);
+    ARMARX_CHECK_GREATER(m_size, 0);
 
-    return m_observations.back();
+    return m_observations[slot(m_size - 1)];
 }
 
 
 observation::ptr
 known_object::past_observation() const
 {
-    ARMARX_CHECK_GREATER(m_observations.size(), 0);
+    return past_observations({default_past_horizon}).front();
+}
+
+
+std::vector<observation::ptr>
+known_object::past_observations(const std::vector<std::chrono::milliseconds>& horizons) const
+{
+    const std::vector<std::size_t> indices = past_indices(horizons);
+
+    std::vector<observation::ptr> past;
+    past.reserve(indices.size());
+    for (const std::size_t index : indices)
+        past.push_back(m_observations[slot(index)]);
+
+    return past;
+}
+
+
+std::vector<visionx::BoundingBox3D>
+known_object::past_bounding_boxes(const std::vector<std::chrono::milliseconds>& horizons) const
+{
+    const std::vector<std::size_t> indices = past_indices(horizons);
+
+    std::vector<visionx::BoundingBox3D> past;
+    past.reserve(indices.size());
+    for (const std::size_t index : indices)
+        past.push_back(m_bounding_boxes[slot(index)]);
 
-    const std::chrono::milliseconds limit{333}; // in the Paper, they use 10 frames at 30 fps => ca. 333ms
-    const std::chrono::microseconds deadline = current_observation()->seen_at() - limit;
+    return past;
+}
 
-    unsigned int i = 0;
-    while (m_observations[i]->seen_at() < deadline)
-        ++i;
 
-    return m_observations[i];
+void
+known_object::current_bounding_box(const visionx::BoundingBox3D& bounding_box)
+{
+    ARMARX_CHECK_GREATER(m_size, 0);
+
+    const std::size_t current = slot(m_size - 1);
+    m_observations[current]->bounding_box(bounding_box);
+    m_bounding_boxes[current] = bounding_box;
+    m_has_bounding_box[current] = true;
 }
 
 
@@ -129,95 +166,160 @@ visionx::BoundingBox3D
 known_object::average_bounding_boxes(
         const visionx::BoundingBox3D& current,
         std::chrono::microseconds now,
-        std::chrono::milliseconds max_age) const
+        const bounding_box_smoother& smoother)
 {
-    // Function evaluating the gaussian function to get an appropriate weight
-    const auto get_gaussian_weight = [](double x, double sigma) -> double
-    {
-        // W|A: (1/(sqrt(2π)*σ))*e^(-x²/(2*σ²))
-        //      |---- coef ----|   | exp_arg |
-        // with σ = sigma
-        const constexpr double two_pi = 2 * M_PI;
-        const double coef = 1. / (std::sqrt(two_pi) * sigma);
-        const double exp_arg = -std::pow(x, 2) / (2 * std::pow(sigma, 2));
-        return coef * std::exp(exp_arg);
-    };
-
-    // Find possible candidates
-    std::vector<std::tuple<double, visionx::BoundingBox3D>> candidates;
+    if (smoother.kernel() == smoothing_kernel::exponential)
     {
-        const double sigma = static_cast<double>(max_age.count()) / 3; // 3*sigma = max_age
-        const std::chrono::microseconds deadline = now - max_age;
-        for (unsigned int i = 0; i < m_observations.size(); ++i)
+        // Add the bounding boxes remembered since the last call to the running sums, decaying the sums to the time
+        // of each of them.  Usually, this is at most the previous bounding box
+        for (std::size_t i = first_seen_at_or_after(m_exponential_sums_at + std::chrono::microseconds{1});
+             i < m_size; ++i)
         {
-            observation::ptr observation = m_observations[i];
-            if (observation->seen_at() > deadline and observation->has_bounding_box_set())
-            {
-                const std::chrono::milliseconds diff
-                        = std::chrono::duration_cast<std::chrono::milliseconds>(now - observation->seen_at());
-                const double weight = get_gaussian_weight((diff).count(), sigma);
-                candidates.push_back(std::make_tuple(weight, observation->bounding_box()));
-            }
+            const std::size_t s = slot(i);
+            if (m_seen_at[s] > now)
+                break;
+            if (not m_has_bounding_box[s])
+                continue;
+
+            if (m_exponential_sums.weight > 0)
+                m_exponential_sums.scale(smoother.decay(m_seen_at[s] - m_exponential_sums_at));
+            m_exponential_sums.add(1, m_bounding_boxes[s]);
+            m_exponential_sums_at = m_seen_at[s];
         }
 
-        // Current observation is added as well, with the biggest weight
-        candidates.push_back(std::make_tuple(get_gaussian_weight(0, sigma), current));
+        bounding_box_sums sums = m_exponential_sums;
+        if (sums.weight > 0)
+            sums.scale(smoother.decay(now - m_exponential_sums_at));
+        sums.add(1, current);
+        return sums.mean();
     }
 
-    // Find normalisation value
-    double normalisation;
-    {
-        double weight_sum = 0;
-        for (const auto& t : candidates)
-        {
-            const double weight = std::get<0>(t);
-            weight_sum += weight;
-        }
-        normalisation = 1. / weight_sum;
-    }
+    const std::chrono::microseconds deadline = now - smoother.window();
+
+    // Observations seen after the deadline, found by binary search.  Only those with a bounding box are candidates
+    std::size_t first = first_seen_at_or_after(deadline);
+    while (first < m_size and m_seen_at[slot(first)] <= deadline)
+        ++first;
 
-    // Calculate mean and return it
-    visionx::BoundingBox3D mean;
-    mean.x0 = mean.x1 = mean.y0 = mean.y1 = mean.z0 = mean.z1 = 0;
-    for (const auto& t : candidates)
+    // Weighted sums of the candidates in one pass over the window, with the weights looked up by age.  The current
+    // bounding box is added as well, with the biggest weight
+    bounding_box_sums sums;
+    for (std::size_t i = first; i < m_size; ++i)
     {
-        const double weight = std::get<0>(t);
-        const visionx::BoundingBox3D& candidate = std::get<1>(t);
-        mean.x0 += (weight * normalisation) * candidate.x0;
-        mean.x1 += (weight * normalisation) * candidate.x1;
-        mean.y0 += (weight * normalisation) * candidate.y0;
-        mean.y1 += (weight * normalisation) * candidate.y1;
-        mean.z0 += (weight * normalisation) * candidate.z0;
-        mean.z1 += (weight * normalisation) * candidate.z1;
+        const std::size_t s = slot(i);
+        if (not m_has_bounding_box[s])
+            continue;
+
+        const std::chrono::milliseconds age = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_seen_at[s]);
+        sums.add(smoother.weight(age), m_bounding_boxes[s]);
     }
+    sums.add(smoother.weight(std::chrono::milliseconds::zero()), current);
 
-    return mean;
+    return sums.mean();
 }
 
 
 void
 known_object::remember_observation(observation::ptr observation)
 {
-    m_observations.push_back(observation);
+    if (m_size == m_observations.size())
+        grow();
+
+    const std::size_t next = slot(m_size);
+    m_seen_at[next] = observation->seen_at();
+    m_bounding_boxes[next] = observation->bounding_box();
+    m_has_bounding_box[next] = observation->has_bounding_box_set();
+    m_observations[next] = std::move(observation);
+    ++m_size;
 }
 
 
 void
 known_object::forget_observations(std::chrono::microseconds now, std::chrono::microseconds older_than)
 {
-    ARMARX_CHECK_GREATER(m_observations.size(), 0);
+    ARMARX_CHECK_GREATER(m_size, 0);
 
     // Given older_than, calculate absolute deadline
     const std::chrono::microseconds deadline = now - older_than;
 
-    // Forget all observations older than absolute deadline
-    while (m_observations.size() > 0 and m_observations.front()->seen_at() < deadline)
-        m_observations.pop_front();
+    // Forget all observations older than absolute deadline by advancing the head.  Releasing them returns them to
+    // their pool
+    const std::size_t forgotten = first_seen_at_or_after(deadline);
+    for (std::size_t i = 0; i < forgotten; ++i)
+        m_observations[slot(i)].reset();
+    m_head = slot(forgotten);
+    m_size -= forgotten;
 }
 
 
 bool
 known_object::all_observations_forgotten() const
 {
-    return m_observations.size() == 0;
+    return m_size == 0;
+}
+
+
+std::size_t
+known_object::slot(std::size_t index) const
+{
+    return (m_head + index) & (m_observations.size() - 1);
+}
+
+
+std::size_t
+known_object::first_seen_at_or_after(std::chrono::microseconds deadline) const
+{
+    std::size_t low = 0;
+    std::size_t high = m_size;
+    while (low < high)
+    {
+        const std::size_t middle = low + (high - low) / 2;
+        if (m_seen_at[slot(middle)] < deadline)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+
+std::vector<std::size_t>
+known_object::past_indices(const std::vector<std::chrono::milliseconds>& horizons) const
+{
+    ARMARX_CHECK_GREATER(m_size, 0);
+
+    const std::chrono::microseconds now = m_seen_at[slot(m_size - 1)];
+    std::vector<std::size_t> indices;
+    indices.reserve(horizons.size());
+
+    // Terminates at the latest with the current observation
+    for (const std::chrono::milliseconds& horizon : horizons)
+        indices.push_back(first_seen_at_or_after(now - horizon));
+
+    return indices;
+}
+
+
+void
+known_object::grow()
+{
+    const std::size_t capacity = m_observations.empty() ? default_history_capacity : m_observations.size() * 2;
+
+    std::vector<observation::ptr> observations(capacity);
+    std::vector<std::chrono::microseconds> seen_at(capacity);
+    std::vector<visionx::BoundingBox3D> bounding_boxes(capacity);
+    std::vector<std::uint8_t> has_bounding_box(capacity);
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        observations[i] = std::move(m_observations[slot(i)]);
+        seen_at[i] = m_seen_at[slot(i)];
+        bounding_boxes[i] = m_bounding_boxes[slot(i)];
+        has_bounding_box[i] = m_has_bounding_box[slot(i)];
+    }
+
+    m_observations = std::move(observations);
+    m_seen_at = std::move(seen_at);
+    m_bounding_boxes = std::move(bounding_boxes);
+    m_has_bounding_box = std::move(has_bounding_box);
+    m_head = 0;
 }
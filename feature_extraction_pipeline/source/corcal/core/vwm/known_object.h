@@ -25,13 +25,18 @@
 
 
 // STD/STL
-#include <deque>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 // VisionX
 #include <VisionX/interface/core/DataTypes.h>
 
 // corcal
+#include <corcal/core/vwm/bounding_box_smoother.h>
+#include <corcal/core/vwm/class_registry.h>
 #include <corcal/core/vwm/observation.h>
 
 
@@ -49,11 +54,39 @@ class known_object
 
         using ptr = std::shared_ptr<known_object>;
 
+        /**
+         * @brief Look-back of past_observation.  In the paper, they use 10 frames at 30 fps => ca. 333ms
+         */
+        static constexpr std::chrono::milliseconds default_past_horizon{333};
+
+        /**
+         * @brief Initial capacity of the observation history, enough for 2 s at 30 fps
+         */
+        static constexpr std::size_t default_history_capacity = 64;
+
     private:
 
         std::string m_id = "";
-        std::string m_class_name = "";
-        std::deque<observation::ptr> m_observations;
+        vwm::class_id m_class_id = class_registry::no_class;
+
+        /**
+         * @brief Ring buffer of the observations ordered by time, from m_head on, with their timestamps and 3D
+         *        bounding boxes in parallel arrays.  The capacity is a power of two and doubles if the ring is full
+         */
+        std::vector<observation::ptr> m_observations;
+        std::vector<std::chrono::microseconds> m_seen_at;
+        std::vector<visionx::BoundingBox3D> m_bounding_boxes;
+        std::vector<std::uint8_t> m_has_bounding_box;
+        std::size_t m_head = 0;
+        std::size_t m_size = 0;
+
+        /**
+         * @brief Running sums of the exponential smoothing kernel, including all bounding boxes seen at
+         *        m_exponential_sums_at or earlier, weighted as of m_exponential_sums_at
+         */
+        bounding_box_sums m_exponential_sums;
+        std::chrono::microseconds m_exponential_sums_at{std::chrono::microseconds::min()};
+
         float m_last_zmin;
         float m_last_zmax;
 
@@ -70,25 +103,54 @@ class known_object
 
         const std::string& id() const;
 
+        /**
+         * @brief Name of the class, looked up in the global class_registry
+         */
         const std::string& class_name() const;
 
+        vwm::class_id class_id() const;
+
         observation::ptr current_observation() const;
 
+        /**
+         * @brief Oldest observation not older than default_past_horizon relative to the current observation
+         */
         observation::ptr past_observation() const;
 
         /**
-         * @brief Averages the last verified bounding boxes, with the current observation weighted double, to smooth
-         *        the results
-         * @param current
-         * @param now
-         * @param max_age
-         * @return
+         * @brief Oldest observation not older than the respective horizon relative to the current observation, for
+         *        each of the given horizons, found by binary search
+         * @param horizons Look-back durations, in any order
+         * @return One observation per horizon, in the order of horizons
+         */
+        std::vector<observation::ptr> past_observations(const std::vector<std::chrono::milliseconds>& horizons) const;
+
+        /**
+         * @brief Bounding boxes of the observations past_observations would return, read from the history without
+         *        touching the observations
+         */
+        std::vector<visionx::BoundingBox3D> past_bounding_boxes(
+            const std::vector<std::chrono::milliseconds>& horizons
+        ) const;
+
+        /**
+         * @brief Sets the 3D bounding box of the current observation, in the observation and in the history
+         */
+        void current_bounding_box(const visionx::BoundingBox3D& bounding_box);
+
+        /**
+         * @brief Averages the last verified bounding boxes with the current one, weighted by their age with the kernel
+         *        of smoother, to smooth the results.  The current bounding box gets the biggest weight
+         *
+         * With the exponential kernel, the bounding boxes remembered since the last call are added to the running
+         * sums, so that each call costs O(1) amortised.  A known object should therefore always be smoothed with the
+         * same smoother.
          */
         visionx::BoundingBox3D average_bounding_boxes(
             const visionx::BoundingBox3D& current,
             std::chrono::microseconds now,
-            std::chrono::milliseconds max_age
-        ) const;
+            const bounding_box_smoother& smoother
+        );
 
         void remember_observation(observation::ptr o);
 
@@ -96,6 +158,28 @@ class known_object
 
         bool all_observations_forgotten() const;
 
+    private:
+
+        /**
+         * @brief Position in the ring of the observation at the given index, where 0 is the oldest
+         */
+        std::size_t slot(std::size_t index) const;
+
+        /**
+         * @brief Index of the oldest observation seen at deadline or later, found by binary search
+         */
+        std::size_t first_seen_at_or_after(std::chrono::microseconds deadline) const;
+
+        /**
+         * @brief Index of the observation for each horizon, relative to the current observation
+         */
+        std::vector<std::size_t> past_indices(const std::vector<std::chrono::milliseconds>& horizons) const;
+
+        /**
+         * @brief Doubles the capacity of the ring, moving the oldest observation to the front
+         */
+        void grow();
+
 };
 
 
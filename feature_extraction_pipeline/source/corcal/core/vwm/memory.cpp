@@ -25,27 +25,34 @@
 
 
 // STD/STL
-#include <algorithm> // for begin, end, remove
+#include <algorithm> // for begin, end, find
 #include <cmath> // for hypot, pow, sqrt
 #include <limits> // for numerical_limits
-
-// PF
-#include <sisr_filter.h>
+#include <numeric> // for iota
+#include <tuple> // for tie
+#include <unordered_map>
+#include <utility> // for move
 
 // ArmarX
 #include <ArmarXCore/core/exceptions/local/ExpressionException.h> // for ARMARX_CHECK_* assertions
 
+// corcal
+#include <corcal/core/vwm/assignment.h>
+#include <corcal/core/vwm/class_registry.h>
+
 
 using namespace corcal::core::vwm;
 
 
-memory::memory()
+memory::memory() :
+    m_observation_pool{observation_pool::create()}
 {
     // pass
 }
 
 
-memory::memory(float initial_certainty_threshold, std::chrono::milliseconds remember_duration)
+memory::memory(float initial_certainty_threshold, std::chrono::milliseconds remember_duration) :
+    m_observation_pool{observation_pool::create()}
 {
     m_initial_certainty_threshold = initial_certainty_threshold;
     m_remember_duration = remember_duration;
@@ -81,11 +88,33 @@ memory::now(const std::chrono::microseconds& value)
 
 
 void
-memory::make_observations(const std::vector<observation::ptr>& observations)
+memory::match_gating_distance(double value)
+{
+    m_match_gating_distance = value;
+    m_known_object_grid = spatial_grid{std::isfinite(value) ? value : 1};
+    update_known_object_grid();
+}
+
+
+observation::ptr
+memory::new_observation()
 {
-    std::vector<observation::ptr> observations_mutable = observations;
+    return m_observation_pool->acquire();
+}
 
-    SISRFilter<1000, > cff;
+
+observation_pool&
+memory::pool()
+{
+    return *m_observation_pool;
+}
+
+
+void
+memory::make_observations(const std::vector<observation::ptr>& observations)
+{
+    std::vector<observation::ptr>& observations_mutable = m_unmatched_observations;
+    observations_mutable.assign(std::begin(observations), std::end(observations));
 
     // Refresh memory using the new observations.
     {
@@ -104,6 +133,9 @@ memory::make_observations(const std::vector<observation::ptr>& observations)
                 m_known_objects.push_back(known_object);
             }
         }
+
+        // Drop the references to discarded observations, so that they are recycled right away
+        observations_mutable.clear();
     }
 
     // Forget outdated observations.
@@ -126,120 +158,187 @@ memory::make_observations(const std::vector<observation::ptr>& observations)
 
             known_object->forget_observations(now, m_remember_duration);
             if (known_object->all_observations_forgotten())
+            {
+                m_known_object_grid.erase(known_object.get());
                 it = m_known_objects.erase(it);
+            }
             else
+            {
                 std::advance(it, 1);
+            }
         }
     }
+
+    // Move matched known objects in the grid and insert new ones.
+    update_known_object_grid();
 }
 
 
 void
 memory::match_observations_to_known_objects(std::vector<observation::ptr>& observations) const
 {
-    // Helper to find possible match candidates by target class name
-    auto find_possible_matches = [](
-        const std::vector<observation::ptr>& observations,
-        const std::string& target_class_name
-    ) -> std::vector<observation::ptr>
-    {
-        std::vector<observation::ptr> match_candidates;
+    if (observations.empty() or m_known_objects.empty()) return;
 
-        for (observation::ptr observation : observations)
-            for (const candidate& candidate : observation->candidates())
-                if (candidate.class_name() == target_class_name)
-                    match_candidates.push_back(observation);
+    const std::size_t known_objects_count = m_known_objects.size();
 
-        ARMARX_CHECK_LESS_EQUAL_W_HINT(match_candidates.size(), observations.size(), "Filtered vector of candidates "
-            "cannot have more elements than the input vector");
-
-        return match_candidates;
+    // Pairs of a known object and an observation which can be matched, with their distance.  The group is assigned
+    // once all pairs are known
+    struct possible_match
+    {
+        std::size_t group;
+        std::size_t known_object;
+        std::size_t observation;
+        double distance;
     };
+    std::vector<possible_match> possible_matches;
 
-    // Helper to find the observation that matches best to the last confirmed observation.
-    auto find_best_match = [](
-        std::vector<observation::ptr>& possible_matches,
-        observation::ptr last_confirmed_observation
-    ) -> observation::ptr
+    if (std::isfinite(m_match_gating_distance))
     {
-        ARMARX_CHECK_GREATER_EQUAL_W_HINT(possible_matches.size(), 1, "The input vector of possible matches to pick "
-            "the best match from cannot be empty");
+        // Known objects near each observation, from the grid
+        std::unordered_map<const known_object*, std::size_t> known_object_indices;
+        known_object_indices.reserve(known_objects_count);
+        for (std::size_t k = 0; k < known_objects_count; ++k)
+            known_object_indices.emplace(m_known_objects[k].get(), k);
 
-        // Pairwise compare possible matches and eliminate the worse in each loop
-        while (possible_matches.size() > 1)
+        for (std::size_t o = 0; o < observations.size(); ++o)
         {
-            // Ensure that there are at least two elements left in the list, remember list size
-            const unsigned long int possible_matches_size_pre = possible_matches.size();
-            ARMARX_CHECK_GREATER_EQUAL(possible_matches_size_pre, 2);
-
-            // Considered candidates in this loop
-            observation::ptr candiate1 = possible_matches.at(0);
-            observation::ptr candidate2 = possible_matches.at(1);
-
-            // Calculate distance to first and second candidate in candidates list
-            const double distance1 = last_confirmed_observation->distance_to(candiate1);
-            const double distance2 = last_confirmed_observation->distance_to(candidate2);
-
-            // Find the elimination candidate
-            observation::ptr elimination_candidate = distance1 <= distance2 ? candidate2 : candiate1;
-
-            // Delete the elimination candidate from the list of possible matches
-            possible_matches.erase(
-                std::remove(std::begin(possible_matches), std::end(possible_matches), elimination_candidate),
-                std::end(possible_matches)
-            );
-
-            // Ensure that exactly one element was deleted from the list
-            ARMARX_CHECK_EQUAL(possible_matches_size_pre, possible_matches.size() + 1);
+            const observation::ptr& observation = observations[o];
+            const candidate_list& candidates = observation->candidates();
+            m_known_object_grid.for_each_near(observation->cx(), observation->cy(), m_match_gating_distance,
+                                              [&](const known_object* known_object)
+            {
+                const class_id id = known_object->class_id();
+                if (std::none_of(std::begin(candidates), std::end(candidates),
+                                 [id](const candidate& candidate) { return candidate.class_id() == id; }))
+                    return;
+
+                const double distance = known_object->current_observation()->distance_to(observation);
+                if (distance <= m_match_gating_distance)
+                    possible_matches.push_back({0, known_object_indices.at(known_object), o, distance});
+            });
         }
+    }
+    else
+    {
+        // Known objects of each class in the registry.  Observations interned their classes before matching, so all
+        // their ids are covered
+        std::vector<std::vector<std::size_t>> class_known_objects(class_registry::global().size());
+        for (std::size_t k = 0; k < known_objects_count; ++k)
+            class_known_objects[m_known_objects[k]->class_id()].push_back(k);
 
-        // Ensure that there is exactly one possible match left, that is, the best match
-        ARMARX_CHECK_EQUAL(possible_matches.size(), 1);
+        for (std::size_t o = 0; o < observations.size(); ++o)
+        {
+            const candidate_list& candidates = observations[o]->candidates();
+            for (auto candidate = std::begin(candidates); candidate != std::end(candidates); ++candidate)
+            {
+                const class_id id = candidate->class_id();
+                if (id >= class_known_objects.size()
+                    or std::any_of(std::begin(candidates), candidate,
+                                   [id](const vwm::candidate& previous) { return previous.class_id() == id; }))
+                    continue;
+
+                for (const std::size_t k : class_known_objects[id])
+                {
+                    const double distance = m_known_objects[k]->current_observation()->distance_to(observations[o]);
+                    possible_matches.push_back({0, k, o, distance});
+                }
+            }
+        }
+    }
 
-        // Return the best match
-        return possible_matches.at(0);
+    // Groups of known objects (nodes [0, known_objects_count)) and observations (nodes from known_objects_count on)
+    // connected by possible matches, with a union-find
+    std::vector<std::size_t> node_group(known_objects_count + observations.size());
+    std::iota(std::begin(node_group), std::end(node_group), 0);
+    const auto find_group = [&node_group](std::size_t node)
+    {
+        while (node_group[node] != node)
+            node = node_group[node] = node_group[node_group[node]];
+        return node;
     };
-
-    // Helper to transfer the best match from the observations list to the known object
-    auto transfer_best_match = [](
-        observation::ptr best_match,
-        std::vector<observation::ptr>& observations,
-        known_object::ptr known_object
-    ) -> void
+    for (const possible_match& match : possible_matches)
+        node_group[find_group(match.known_object)] = find_group(known_objects_count + match.observation);
+    for (possible_match& match : possible_matches)
+        match.group = find_group(match.known_object);
+    std::sort(std::begin(possible_matches), std::end(possible_matches),
+              [](const possible_match& a, const possible_match& b)
     {
-        const unsigned long int observations_size_pre = observations.size();
-        ARMARX_CHECK_GREATER_EQUAL_W_HINT(observations_size_pre, 1, "Cannot transfer the best match if the source "
-            "vector is empty");
+        return std::tie(a.group, a.known_object, a.observation) < std::tie(b.group, b.known_object, b.observation);
+    });
+
+    // Solve each group on its own, where known objects are the rows and observations the columns
+    constexpr std::size_t no_index = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> local_index(node_group.size(), no_index);
+    std::vector<std::size_t> rows;
+    std::vector<std::size_t> cols;
+    std::vector<bool> matched(observations.size(), false);
+    std::vector<double> costs;
+    for (auto group_begin = std::begin(possible_matches); group_begin != std::end(possible_matches);)
+    {
+        const auto group_end = std::find_if(group_begin, std::end(possible_matches),
+                                            [group_begin](const possible_match& match)
+        {
+            return match.group != group_begin->group;
+        });
+
+        rows.clear();
+        cols.clear();
+        for (auto match = group_begin; match != group_end; ++match)
+        {
+            if (local_index[match->known_object] == no_index)
+            {
+                local_index[match->known_object] = rows.size();
+                rows.push_back(match->known_object);
+            }
+            const std::size_t observation_node = known_objects_count + match->observation;
+            if (local_index[observation_node] == no_index)
+            {
+                local_index[observation_node] = cols.size();
+                cols.push_back(match->observation);
+            }
+        }
 
-        known_object->remember_observation(best_match);
+        costs.assign(rows.size() * cols.size(), std::numeric_limits<double>::infinity());
+        for (auto match = group_begin; match != group_end; ++match)
+        {
+            costs[local_index[match->known_object] * cols.size()
+                  + local_index[known_objects_count + match->observation]] = match->distance;
+        }
 
-        // Remove the best match from the list of observations
-        observations.erase(
-            std::remove(std::begin(observations), std::end(observations), best_match),
-            std::end(observations)
-        );
+        const std::vector<int> assignment = solve_assignment(costs, rows.size(), cols.size());
+        for (std::size_t r = 0; r < rows.size(); ++r)
+        {
+            if (assignment[r] < 0) continue;
 
-        // Ensure that exactly one item was deleted from observations list
-        ARMARX_CHECK_EQUAL(observations_size_pre, observations.size() + 1);
-    };
+            const std::size_t o = cols[static_cast<std::size_t>(assignment[r])];
+            ARMARX_CHECK_EXPRESSION_W_HINT(not matched[o], "Observation matched to more than one known object");
+            m_known_objects[rows[r]]->remember_observation(observations[o]);
+            matched[o] = true;
+        }
 
-    for (known_object::ptr known_object : m_known_objects)
-    {
-        // If there's nothing to match against (anymore), exit early
-        if (observations.size() == 0) return;
+        for (const std::size_t k : rows)
+            local_index[k] = no_index;
+        for (const std::size_t o : cols)
+            local_index[known_objects_count + o] = no_index;
+        group_begin = group_end;
+    }
 
-        // Find possible matches for the known object by class name
-        std::vector<observation::ptr> possible_matches = find_possible_matches(observations, known_object->class_name());
+    // Remove the matched observations in a single pass, keeping the order of the others
+    std::size_t kept = 0;
+    for (std::size_t o = 0; o < observations.size(); ++o)
+        if (not matched[o])
+            observations[kept++] = std::move(observations[o]);
+    observations.resize(kept);
+}
 
-        // If there are no candidates, continue
-        if (possible_matches.size() == 0) continue;
 
-        // Find the candidate which matches best to the last confirmed observation
-        observation::ptr best_match = find_best_match(possible_matches, known_object->current_observation());
+void
+memory::update_known_object_grid()
+{
+    if (not std::isfinite(m_match_gating_distance)) return;
 
-        // Transfer the best match from the observations list to the known object
-        transfer_best_match(best_match, observations, known_object);
-    }
+    for (const known_object::ptr& known_object : m_known_objects)
+        m_known_object_grid.update(known_object.get());
 }
 
 
@@ -248,6 +347,7 @@ memory::reset()
 {
     m_id_counter = 0;
     m_known_objects.clear();
+    m_known_object_grid.clear();
 }
 
 
@@ -26,12 +26,15 @@
 
 // STD/STL
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <vector>
 
 // corcal
 #include <corcal/core/vwm/known_object.h>
 #include <corcal/core/vwm/observation.h>
+#include <corcal/core/vwm/observation_pool.h>
+#include <corcal/core/vwm/spatial_grid.h>
 
 
 namespace corcal::core::vwm
@@ -72,6 +75,28 @@ class memory
          */
         float m_initial_certainty_threshold;
 
+        /**
+         * @brief Maximum distance between an observation and the current observation of a known object for them to
+         *        be matched
+         */
+        double m_match_gating_distance = std::numeric_limits<double>::infinity();
+
+        /**
+         * @brief Known objects by the centre of their current observation, with cells as large as the gating distance.
+         *        Only kept up to date if the gating distance is finite
+         */
+        spatial_grid m_known_object_grid;
+
+        /**
+         * @brief Pool recycling the observations of this memory, see new_observation
+         */
+        std::shared_ptr<observation_pool> m_observation_pool;
+
+        /**
+         * @brief Observations not matched to a known object yet, kept to reuse its allocation across frames
+         */
+        std::vector<observation::ptr> m_unmatched_observations;
+
     public:
 
         memory();
@@ -83,6 +108,14 @@ class memory
         void initial_certainty_threshold(float value);
         void remember_duration(const std::chrono::milliseconds& value);
         void now(const std::chrono::microseconds& value);
+        void match_gating_distance(double value);
+
+        /**
+         * @brief New observation from the pool of this memory, which is recycled once it is no longer referenced
+         */
+        observation::ptr new_observation();
+
+        observation_pool& pool();
 
         virtual void make_observations(const std::vector<observation::ptr>& observations);
 
@@ -92,8 +125,23 @@ class memory
 
     protected:
 
+        /**
+         * @brief Matches the observations to the known objects, and removes the matched ones from observations
+         *
+         * An observation can be matched to a known object if one of its candidates has the class of the known object,
+         * and if its distance to the current observation of the known object is at most the gating distance.  Among
+         * all assignments matching as many known objects as possible, the one with the least sum of distances is
+         * chosen.  With a finite gating distance, the known objects near an observation are looked up in
+         * m_known_object_grid, otherwise all known objects of its classes are considered.  Each connected group of
+         * known objects and observations which can be matched is solved on its own with solve_assignment.
+         */
         virtual void match_observations_to_known_objects(std::vector<observation::ptr>& observations) const;
 
+        /**
+         * @brief Moves the known objects in m_known_object_grid to their current observations, and inserts new ones
+         */
+        void update_known_object_grid();
+
 };
 
 
@@ -29,6 +29,7 @@
 #include <cmath> // hypot, pow, sqrt
 #include <memory>
 #include <string>
+#include <utility>
 
 // ArmarX
 #include <ArmarXCore/core/exceptions/local/ExpressionException.h>
@@ -36,21 +37,47 @@
 // VisionX
 #include <VisionX/interface/core/DataTypes.h>
 
+// corcal
+#include <corcal/core/vwm/observation_pool.h>
+
 
 using namespace corcal::core::vwm;
 
 
-const std::vector<candidate>&
+observation::observation() :
+    m_reference_count{0}
+{
+    clear();
+}
+
+
+observation::ptr
+observation::create()
+{
+    return ptr{new observation};
+}
+
+
+const candidate_list&
 observation::candidates() const
 {
     return m_candidates;
 }
 
 
+candidate_list&
+observation::candidates()
+{
+    return m_candidates;
+}
+
+
 void
-observation::candidates(const std::vector<candidate>& value)
+observation::candidates(const candidate_list& value)
 {
-    m_candidates = value;
+    m_candidates.clear();
+    for (const candidate& candidate : value)
+        m_candidates.push_back(candidate);
 }
 
 
@@ -238,3 +265,39 @@ observation::distance_to(observation::ptr other) const
     return std::hypot(static_cast<double>(m_cx) - static_cast<double>(other->m_cx),
                       static_cast<double>(m_cy) - static_cast<double>(other->m_cy));
 }
+
+
+void
+observation::clear()
+{
+    m_class_count = 0;
+    m_candidates.clear();
+    m_seen_at = std::chrono::microseconds::zero();
+    m_cx = 0;
+    m_cy = 0;
+    m_w = 0;
+    m_h = 0;
+    m_xmin = 0;
+    m_xmax = 0;
+    m_ymin = 0;
+    m_ymax = 0;
+    m_has_bounding_box_set = false;
+    m_bounding_box = visionx::BoundingBox3D{};
+}
+
+
+void
+observation::release(observation* released)
+{
+    ARMARX_CHECK_EQUAL(released->m_reference_count.load(), 0);
+
+    if (not released->m_pool)
+    {
+        delete released;
+        return;
+    }
+
+    // The pool may only go away once the observation is back
+    const std::shared_ptr<observation_pool> pool = std::move(released->m_pool);
+    pool->release(released);
+}
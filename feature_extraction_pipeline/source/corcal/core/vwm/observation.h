@@ -25,9 +25,13 @@
 
 
 // STD/STL
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 // VisionX
 #include <VisionX/interface/core/DataTypes.h>
@@ -40,20 +44,90 @@ namespace corcal { namespace core { namespace vwm
 {
 
 
+class observation;
+class observation_pool;
+
+
+/**
+ * @brief Intrusive reference counting pointer to an observation
+ *
+ * The reference count lives in the observation itself.  Once the last pointer to an observation is gone, it is
+ * returned to the observation_pool it was acquired from, or deleted if it was created with observation::create.
+ */
+class observation_ptr
+{
+
+    private:
+
+        observation* m_observation;
+
+    public:
+
+        observation_ptr() noexcept;
+        observation_ptr(std::nullptr_t) noexcept;
+        observation_ptr(const observation_ptr& other) noexcept;
+        observation_ptr(observation_ptr&& other) noexcept;
+        ~observation_ptr();
+
+        observation_ptr& operator=(observation_ptr other) noexcept;
+
+        void reset() noexcept;
+
+        observation* get() const noexcept;
+        observation& operator*() const noexcept;
+        observation* operator->() const noexcept;
+
+        explicit operator bool() const noexcept;
+
+        /**
+         * @brief Number of pointers to the observation, or 0 if null
+         */
+        std::size_t use_count() const noexcept;
+
+        friend bool operator==(const observation_ptr& a, const observation_ptr& b) noexcept;
+        friend bool operator!=(const observation_ptr& a, const observation_ptr& b) noexcept;
+
+    private:
+
+        friend class observation;
+        friend class observation_pool;
+
+        /**
+         * @brief Takes a reference to the given observation
+         */
+        explicit observation_ptr(observation* target) noexcept;
+
+};
+
+
 /**
  * @brief An object of this class represents an individual general observation
+ *
+ * Observations are created with observation::create, or recycled from an observation_pool (see
+ * memory::new_observation), and shared through intrusive reference counting pointers.
  */
 class observation
 {
 
     public:
 
-        using ptr = std::shared_ptr<observation>;
+        using ptr = observation_ptr;
 
     private:
 
+        friend class observation_ptr;
+        friend class observation_pool;
+
+        std::atomic<unsigned int> m_reference_count;
+
+        /**
+         * @brief Pool the observation is returned to once it is no longer referenced, held while it is referenced,
+         *        or null if it was created with observation::create
+         */
+        std::shared_ptr<observation_pool> m_pool;
+
         int m_class_count;
-        std::vector<candidate> m_candidates;
+        candidate_list m_candidates;
         std::chrono::microseconds m_seen_at;
         float m_cx;
         float m_cy;
@@ -71,10 +145,21 @@ class observation
         visionx::BoundingBox3D m_bounding_box;
 
 
+        observation();
+
     public:
 
-        const std::vector<candidate>& candidates() const;
-        void candidates(const std::vector<candidate>& value);
+        observation(const observation&) = delete;
+        observation& operator=(const observation&) = delete;
+
+        /**
+         * @brief Creates an observation on the heap, outside of any pool
+         */
+        static ptr create();
+
+        const candidate_list& candidates() const;
+        candidate_list& candidates();
+        void candidates(const candidate_list& value);
         const std::chrono::microseconds& seen_at() const;
         void seen_at(const std::chrono::microseconds& value);
         float cx() const;
@@ -101,7 +186,133 @@ class observation
 
         double distance_to(observation::ptr other) const;
 
+    private:
+
+        /**
+         * @brief Resets all fields as for a new observation.  The candidates keep their storage
+         */
+        void clear();
+
+        /**
+         * @brief Returns the observation to its pool, or deletes it.  Called once it is no longer referenced
+         */
+        static void release(observation* released);
+
 };
 
 
+inline
+observation_ptr::observation_ptr() noexcept :
+    m_observation{nullptr}
+{
+    // pass
+}
+
+
+inline
+observation_ptr::observation_ptr(std::nullptr_t) noexcept :
+    m_observation{nullptr}
+{
+    // pass
+}
+
+
+inline
+observation_ptr::observation_ptr(observation* target) noexcept :
+    m_observation{target}
+{
+    if (m_observation)
+        m_observation->m_reference_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+inline
+observation_ptr::observation_ptr(const observation_ptr& other) noexcept :
+    observation_ptr{other.m_observation}
+{
+    // pass
+}
+
+
+inline
+observation_ptr::observation_ptr(observation_ptr&& other) noexcept :
+    m_observation{other.m_observation}
+{
+    other.m_observation = nullptr;
+}
+
+
+inline
+observation_ptr::~observation_ptr()
+{
+    reset();
+}
+
+
+inline observation_ptr&
+observation_ptr::operator=(observation_ptr other) noexcept
+{
+    std::swap(m_observation, other.m_observation);
+    return *this;
+}
+
+
+inline void
+observation_ptr::reset() noexcept
+{
+    if (m_observation and m_observation->m_reference_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        observation::release(m_observation);
+    m_observation = nullptr;
+}
+
+
+inline observation*
+observation_ptr::get() const noexcept
+{
+    return m_observation;
+}
+
+
+inline observation&
+observation_ptr::operator*() const noexcept
+{
+    return *m_observation;
+}
+
+
+inline observation*
+observation_ptr::operator->() const noexcept
+{
+    return m_observation;
+}
+
+
+inline
+observation_ptr::operator bool() const noexcept
+{
+    return m_observation != nullptr;
+}
+
+
+inline std::size_t
+observation_ptr::use_count() const noexcept
+{
+    return m_observation ? m_observation->m_reference_count.load(std::memory_order_relaxed) : 0;
+}
+
+
+inline bool
+operator==(const observation_ptr& a, const observation_ptr& b) noexcept
+{
+    return a.m_observation == b.m_observation;
+}
+
+
+inline bool
+operator!=(const observation_ptr& a, const observation_ptr& b) noexcept
+{
+    return a.m_observation != b.m_observation;
+}
+
+
 }}}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/vwm/observation_pool.h>
+
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+
+using namespace corcal::core::vwm;
+
+
+observation_pool::observation_pool(std::size_t slab_size) :
+    m_slab_size{slab_size}
+{
+    ARMARX_CHECK_GREATER(slab_size, 0);
+}
+
+
+std::shared_ptr<observation_pool>
+observation_pool::create(std::size_t slab_size)
+{
+    return std::shared_ptr<observation_pool>{new observation_pool{slab_size}};
+}
+
+
+observation::ptr
+observation_pool::acquire()
+{
+    observation* acquired;
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        if (m_free.empty())
+        {
+            m_slabs.emplace_back(new observation[m_slab_size]);
+            m_free.reserve(m_slabs.size() * m_slab_size);
+
+            // Hand out the slots of the new slab in address order
+            observation* const slab = m_slabs.back().get();
+            for (std::size_t i = m_slab_size; i > 0; --i)
+                m_free.push_back(slab + i - 1);
+        }
+
+        acquired = m_free.back();
+        m_free.pop_back();
+    }
+
+    acquired->clear();
+    acquired->m_pool = shared_from_this();
+    return observation::ptr{acquired};
+}
+
+
+std::size_t
+observation_pool::capacity() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_slabs.size() * m_slab_size;
+}
+
+
+std::size_t
+observation_pool::in_use() const
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_slabs.size() * m_slab_size - m_free.size();
+}
+
+
+void
+observation_pool::release(observation* released)
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_free.push_back(released);
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// corcal
+#include <corcal/core/vwm/observation.h>
+
+
+namespace corcal { namespace core { namespace vwm
+{
+
+
+/**
+ * @brief Slab allocator recycling observations
+ *
+ * Observations are allocated in slabs of slab_size slots and returned to the pool once no observation::ptr refers to
+ * them any more.  Recycled observations keep the storage of their candidates, so that once the pool has grown to the
+ * number of observations alive at a time, acquiring observations and filling in their candidates does not allocate.
+ *
+ * Each acquired observation keeps the pool alive until it is returned.  Acquiring and returning observations is
+ * thread-safe.
+ */
+class observation_pool : public std::enable_shared_from_this<observation_pool>
+{
+
+    public:
+
+        static constexpr std::size_t default_slab_size = 256;
+
+    private:
+
+        friend class observation;
+
+        std::size_t m_slab_size;
+        std::vector<std::unique_ptr<observation[]>> m_slabs;
+
+        /**
+         * @brief Slots which are not in use, with capacity for all slots so that returning never allocates
+         */
+        std::vector<observation*> m_free;
+
+        mutable std::mutex m_mutex;
+
+        explicit observation_pool(std::size_t slab_size);
+
+    public:
+
+        static std::shared_ptr<observation_pool> create(std::size_t slab_size = default_slab_size);
+
+        /**
+         * @brief Observation as if newly constructed, from a free slot.  Adds a slab if there is none
+         */
+        observation::ptr acquire();
+
+        /**
+         * @brief Number of slots in all slabs
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Number of acquired observations which were not returned yet
+         */
+        std::size_t in_use() const;
+
+    private:
+
+        void release(observation* released);
+
+};
+
+
+}}}
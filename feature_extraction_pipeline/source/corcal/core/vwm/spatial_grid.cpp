@@ -0,0 +1,105 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#include <corcal/core/vwm/spatial_grid.h>
+
+
+// STD/STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+// ArmarX
+#include <ArmarXCore/core/exceptions/local/ExpressionException.h>
+
+
+using namespace corcal::core::vwm;
+
+
+spatial_grid::spatial_grid(double cell_size)
+{
+    ARMARX_CHECK_EXPRESSION_W_HINT(cell_size >= 0, "Cell size must not be negative");
+
+    // Cells are enlarged if there would be too many to cover [0, 1] exactly
+    m_cells_per_axis = static_cast<std::size_t>(std::clamp(std::ceil(1 / cell_size), 1.,
+                                                           static_cast<double>(max_cells_per_axis)));
+    m_cell_size = std::max(cell_size, 1. / static_cast<double>(m_cells_per_axis));
+    m_cells.resize(m_cells_per_axis * m_cells_per_axis);
+}
+
+
+double
+spatial_grid::cell_size() const
+{
+    return m_cell_size;
+}
+
+
+std::size_t
+spatial_grid::size() const
+{
+    return m_cell_of.size();
+}
+
+
+void
+spatial_grid::update(known_object* object)
+{
+    const observation::ptr current = object->current_observation();
+    const std::size_t cell = cell_coordinate(static_cast<double>(current->cy())) * m_cells_per_axis
+        + cell_coordinate(static_cast<double>(current->cx()));
+
+    const auto [it, inserted] = m_cell_of.emplace(object, cell);
+    if (not inserted)
+    {
+        if (it->second == cell)
+            return;
+
+        std::vector<known_object*>& previous = m_cells[it->second];
+        previous.erase(std::find(std::begin(previous), std::end(previous), object));
+        it->second = cell;
+    }
+    m_cells[cell].push_back(object);
+}
+
+
+void
+spatial_grid::erase(const known_object* object)
+{
+    const auto it = m_cell_of.find(object);
+    if (it == std::end(m_cell_of))
+        return;
+
+    std::vector<known_object*>& cell = m_cells[it->second];
+    cell.erase(std::find(std::begin(cell), std::end(cell), object));
+    m_cell_of.erase(it);
+}
+
+
+void
+spatial_grid::clear()
+{
+    for (std::vector<known_object*>& cell : m_cells)
+        cell.clear();
+    m_cell_of.clear();
+}
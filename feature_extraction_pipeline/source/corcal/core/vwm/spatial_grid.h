@@ -0,0 +1,136 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#pragma once
+
+
+// STD/STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// corcal
+#include <corcal/core/vwm/known_object.h>
+
+
+namespace corcal { namespace core { namespace vwm
+{
+
+
+/**
+ * @brief Uniform grid over normalised image coordinates, bucketing known objects by the centre of their current
+ *        observation
+ *
+ * Covers [0, 1]², where coordinates outside are put into the border cells.  Known objects are inserted, moved and
+ * erased one at a time, so that keeping the grid up to date only touches objects which crossed a cell border.  Does not
+ * own the known objects.
+ */
+class spatial_grid
+{
+
+    public:
+
+        /**
+         * @brief Upper bound of the number of cells along each axis, bounding the memory used for small cell sizes
+         */
+        static constexpr std::size_t max_cells_per_axis = 64;
+
+    private:
+
+        double m_cell_size;
+        std::size_t m_cells_per_axis;
+
+        /**
+         * @brief Known objects of each cell, row-major
+         */
+        std::vector<std::vector<known_object*>> m_cells;
+
+        /**
+         * @brief Cell of each known object in the grid
+         */
+        std::unordered_map<const known_object*, std::size_t> m_cell_of;
+
+    public:
+
+        /**
+         * @brief Empty grid with cells of at least cell_size × cell_size
+         */
+        explicit spatial_grid(double cell_size = 1);
+
+        double cell_size() const;
+
+        /**
+         * @brief Number of known objects in the grid
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Inserts the known object at the centre of its current observation, or moves it there if it is in the
+         *        grid already
+         */
+        void update(known_object* object);
+
+        /**
+         * @brief Removes the known object.  Does nothing if it is not in the grid
+         */
+        void erase(const known_object* object);
+
+        /**
+         * @brief Removes all known objects
+         */
+        void clear();
+
+        /**
+         * @brief Calls f with each known object in a cell which overlaps the square of half side length radius
+         *        around (cx, cy).  This includes all known objects within radius, and possibly some further away
+         */
+        template <typename F>
+        void for_each_near(float cx, float cy, double radius, F&& f) const
+        {
+            const std::size_t x_first = cell_coordinate(static_cast<double>(cx) - radius);
+            const std::size_t x_last = cell_coordinate(static_cast<double>(cx) + radius);
+            const std::size_t y_first = cell_coordinate(static_cast<double>(cy) - radius);
+            const std::size_t y_last = cell_coordinate(static_cast<double>(cy) + radius);
+            for (std::size_t y = y_first; y <= y_last; ++y)
+                for (std::size_t x = x_first; x <= x_last; ++x)
+                    for (known_object* object : m_cells[y * m_cells_per_axis + x])
+                        f(object);
+        }
+
+    private:
+
+        /**
+         * @brief Index of the cell along an axis containing the given coordinate, clamped to the grid
+         */
+        std::size_t cell_coordinate(double coordinate) const
+        {
+            const double cell = std::floor(coordinate / m_cell_size);
+            return static_cast<std::size_t>(std::clamp(cell, 0., static_cast<double>(m_cells_per_axis - 1)));
+        }
+
+};
+
+
+}}}
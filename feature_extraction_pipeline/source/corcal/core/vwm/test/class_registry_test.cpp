@@ -0,0 +1,105 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::vwm::class_registry
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/vwm.h>
+
+
+using namespace corcal::core;
+
+
+BOOST_AUTO_TEST_CASE(names_are_interned_into_dense_ids)
+{
+    class_registry registry;
+    BOOST_CHECK_EQUAL(registry.size(), 1);
+    BOOST_CHECK_EQUAL(registry.intern(""), class_registry::no_class);
+
+    const class_id cup = registry.intern("cup");
+    const class_id bowl = registry.intern("bowl");
+    BOOST_CHECK_EQUAL(cup, 1);
+    BOOST_CHECK_EQUAL(bowl, 2);
+    BOOST_CHECK_EQUAL(registry.intern(std::string{"cup"}), cup);
+    BOOST_CHECK_EQUAL(registry.size(), 3);
+
+    // Names stay where they are when more names are added
+    const std::string& name = registry.name(cup);
+    for (int i = 0; i < 1000; ++i)
+        registry.intern("class_" + std::to_string(i));
+    BOOST_CHECK(&registry.name(cup) == &name);
+    BOOST_CHECK_EQUAL(registry.name(cup), "cup");
+    BOOST_CHECK_EQUAL(registry.name(bowl), "bowl");
+}
+
+
+BOOST_AUTO_TEST_CASE(candidates_and_known_objects_use_the_global_registry)
+{
+    candidate c;
+    BOOST_CHECK_EQUAL(c.class_id(), class_registry::no_class);
+    BOOST_CHECK_EQUAL(c.class_name(), "");
+
+    c.class_name("LeftHand");
+    BOOST_CHECK_EQUAL(c.class_id(), class_registry::global().intern("LeftHand"));
+    BOOST_CHECK_EQUAL(c.class_name(), "LeftHand");
+
+    observation::ptr o = observation::create();
+    o->candidates().push_back(c);
+    const known_object object{o, 3};
+    BOOST_CHECK_EQUAL(object.class_id(), c.class_id());
+    BOOST_CHECK_EQUAL(object.class_name(), "LeftHand");
+    BOOST_CHECK_EQUAL(object.id(), "LeftHand_3");
+}
+
+
+BOOST_AUTO_TEST_CASE(concurrent_interning_agrees_on_ids)
+{
+    class_registry registry;
+    std::vector<std::vector<class_id>> ids(4);
+    std::vector<std::thread> threads;
+    for (std::vector<class_id>& thread_ids : ids)
+    {
+        threads.emplace_back([&registry, &thread_ids]
+        {
+            for (int i = 0; i < 500; ++i)
+                thread_ids.push_back(registry.intern("class_" + std::to_string(i % 100)));
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    BOOST_CHECK_EQUAL(registry.size(), 101);
+    for (const std::vector<class_id>& thread_ids : ids)
+    {
+        BOOST_CHECK(thread_ids == ids.front());
+        for (std::size_t i = 0; i < thread_ids.size(); ++i)
+            BOOST_CHECK_EQUAL(registry.name(thread_ids[i]), "class_" + std::to_string(i % 100));
+    }
+}
@@ -0,0 +1,220 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::vwm::known_object
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/vwm.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    struct reference_entry
+    {
+        observation::ptr remembered;
+        std::chrono::microseconds seen_at;
+        visionx::BoundingBox3D bounding_box;
+        bool has_bounding_box;
+    };
+
+
+    observation::ptr
+    make_observation(std::chrono::microseconds seen_at)
+    {
+        observation::ptr o = observation::create();
+        candidate c;
+        c.class_name("cup");
+        o->candidates().push_back(c);
+        o->seen_at(seen_at);
+        return o;
+    }
+
+
+    visionx::BoundingBox3D
+    random_box(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> position{0, 1000};
+        visionx::BoundingBox3D bb;
+        bb.x0 = position(rng);
+        bb.y0 = position(rng);
+        bb.z0 = position(rng);
+        bb.x1 = bb.x0 + 100;
+        bb.y1 = bb.y0 + 100;
+        bb.z1 = bb.z0 + 100;
+        return bb;
+    }
+
+
+    /**
+     * Oldest entry not older than horizon relative to the newest one, by a linear scan
+     */
+    const reference_entry&
+    reference_past(const std::vector<reference_entry>& history, std::chrono::milliseconds horizon)
+    {
+        const std::chrono::microseconds deadline = history.back().seen_at - horizon;
+        std::size_t i = 0;
+        while (history[i].seen_at < deadline)
+            ++i;
+        return history[i];
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(history_equals_linear_scans)
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> frame_gap{20000, 50000};
+    std::bernoulli_distribution has_box{0.8};
+    const std::vector<std::chrono::milliseconds> horizons{std::chrono::milliseconds{100},
+                                                          known_object::default_past_horizon,
+                                                          std::chrono::milliseconds{0},
+                                                          std::chrono::milliseconds{1000}};
+    const std::chrono::microseconds remember{750000};
+
+    std::chrono::microseconds now{1000000};
+    known_object::ptr object;
+    std::vector<reference_entry> history;
+
+    // Long enough for the ring to wrap around, and a burst to make it grow
+    for (int frame = 0; frame < 600; ++frame)
+    {
+        const int observations_this_frame = frame >= 300 and frame < 310 ? 20 : 1;
+        for (int k = 0; k < observations_this_frame; ++k)
+        {
+            now += std::chrono::microseconds{observations_this_frame == 1 ? frame_gap(rng) : 1000};
+            const observation::ptr o = make_observation(now);
+            if (object)
+                object->remember_observation(o);
+            else
+                object = std::make_shared<known_object>(o, 1);
+            history.push_back({o, now, {}, false});
+
+            if (has_box(rng))
+            {
+                const visionx::BoundingBox3D bb = random_box(rng);
+                object->current_bounding_box(bb);
+                history.back().bounding_box = bb;
+                history.back().has_bounding_box = true;
+            }
+        }
+
+        object->forget_observations(now, remember);
+        while (history.front().seen_at < now - remember)
+            history.erase(history.begin());
+
+        BOOST_REQUIRE(not object->all_observations_forgotten());
+        BOOST_CHECK(object->current_observation() == history.back().remembered);
+
+        const std::vector<observation::ptr> past = object->past_observations(horizons);
+        const std::vector<visionx::BoundingBox3D> past_boxes = object->past_bounding_boxes(horizons);
+        for (std::size_t h = 0; h < horizons.size(); ++h)
+        {
+            const reference_entry& expected = reference_past(history, horizons[h]);
+            BOOST_CHECK(past[h] == expected.remembered);
+            if (expected.has_bounding_box)
+                BOOST_CHECK(past_boxes[h] == expected.bounding_box);
+        }
+        BOOST_CHECK(object->past_observation() == reference_past(history, known_object::default_past_horizon)
+                    .remembered);
+
+        // Gaussian weighted mean of the boxes within the last 300 ms, and the current one
+        const std::chrono::milliseconds max_age{300};
+        const bounding_box_smoother smoother{max_age};
+        const visionx::BoundingBox3D current = random_box(rng);
+        const double sigma = static_cast<double>(max_age.count()) / 3;
+        const auto weight = [sigma](double x)
+        {
+            return std::exp(-x * x / (2 * sigma * sigma)) / (std::sqrt(2 * M_PI) * sigma);
+        };
+        double weight_sum = weight(0);
+        double x0 = weight(0) * current.x0;
+        for (const reference_entry& entry : history)
+        {
+            if (entry.seen_at > now - max_age and entry.has_bounding_box)
+            {
+                const double w = weight(static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.seen_at).count()));
+                weight_sum += w;
+                x0 += w * entry.bounding_box.x0;
+            }
+        }
+        BOOST_CHECK_CLOSE(object->average_bounding_boxes(current, now, smoother).x0, x0 / weight_sum, 1e-3);
+    }
+
+    // Forgetting everything
+    object->forget_observations(now + remember + std::chrono::microseconds{1}, remember);
+    BOOST_CHECK(object->all_observations_forgotten());
+}
+
+
+BOOST_AUTO_TEST_CASE(exponential_smoothing_equals_direct_sums)
+{
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> frame_gap{20000, 50000};
+    const std::chrono::milliseconds window{300};
+    const bounding_box_smoother smoother{window, smoothing_kernel::exponential};
+    const double time_constant = 100000; // [µs]
+
+    std::chrono::microseconds now{1000000};
+    known_object::ptr object;
+    std::vector<reference_entry> boxes;
+
+    for (int frame = 0; frame < 200; ++frame)
+    {
+        now += std::chrono::microseconds{frame_gap(rng)};
+        const observation::ptr o = make_observation(now);
+        if (object)
+            object->remember_observation(o);
+        else
+            object = std::make_shared<known_object>(o, 1);
+
+        // Smoothed bounding box of the current observation, which is remembered for the following frames
+        const visionx::BoundingBox3D current = random_box(rng);
+        const visionx::BoundingBox3D smoothed = object->average_bounding_boxes(current, now, smoother);
+        object->current_bounding_box(smoothed);
+        object->forget_observations(now, std::chrono::microseconds{750000});
+
+        double weight_sum = 1;
+        double z1 = current.z1;
+        for (const reference_entry& entry : boxes)
+        {
+            const double w = std::exp(-static_cast<double>((now - entry.seen_at).count()) / time_constant);
+            weight_sum += w;
+            z1 += w * entry.bounding_box.z1;
+        }
+        BOOST_CHECK_CLOSE(smoothed.z1, z1 / weight_sum, 1e-3);
+
+        boxes.push_back({o, now, smoothed, true});
+    }
+}
@@ -0,0 +1,276 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::vwm::memory
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/vwm.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    const double forbidden = std::numeric_limits<double>::infinity();
+
+
+    observation::ptr
+    make_observation(const std::vector<std::string>& class_names, float cx, float cy, std::chrono::microseconds seen_at)
+    {
+        observation::ptr o = observation::create();
+        for (const std::string& class_name : class_names)
+        {
+            candidate c;
+            c.certainty(1);
+            c.class_name(class_name);
+            c.class_index(0);
+            o->candidates().push_back(c);
+        }
+        o->cx(cx);
+        o->cy(cy);
+        o->seen_at(seen_at);
+        return o;
+    }
+
+
+    /**
+     * Number of assigned rows and their cost of the best assignment, by trying all of them
+     */
+    std::pair<std::size_t, double>
+    brute_force(const std::vector<double>& costs, std::size_t rows, std::size_t cols)
+    {
+        std::pair<std::size_t, double> best{0, 0};
+        std::vector<int> assignment(rows, -1);
+        std::vector<bool> used(cols, false);
+
+        const auto search = [&](const auto& search, std::size_t row, std::size_t count, double cost) -> void
+        {
+            if (row == rows)
+            {
+                if (count > best.first or (count == best.first and cost < best.second))
+                    best = {count, cost};
+                return;
+            }
+
+            search(search, row + 1, count, cost);
+            for (std::size_t col = 0; col < cols; ++col)
+            {
+                if (used[col] or std::isinf(costs[row * cols + col])) continue;
+                used[col] = true;
+                search(search, row + 1, count + 1, cost + costs[row * cols + col]);
+                used[col] = false;
+            }
+        };
+        search(search, 0, 0, 0);
+
+        return best;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(solve_assignment_is_optimal)
+{
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<double> cost{0, 100};
+    std::bernoulli_distribution is_forbidden{0.3};
+
+    for (std::size_t rows = 0; rows <= 5; ++rows)
+    {
+        for (std::size_t cols = 0; cols <= 5; ++cols)
+        {
+            for (int trial = 0; trial < 20; ++trial)
+            {
+                std::vector<double> costs(rows * cols);
+                for (double& c : costs)
+                    c = is_forbidden(rng) ? forbidden : cost(rng);
+
+                const std::vector<int> assignment = vwm::solve_assignment(costs, rows, cols);
+                BOOST_REQUIRE_EQUAL(assignment.size(), rows);
+
+                std::size_t count = 0;
+                double total = 0;
+                std::vector<bool> used(cols, false);
+                for (std::size_t row = 0; row < rows; ++row)
+                {
+                    if (assignment[row] < 0) continue;
+                    const std::size_t col = static_cast<std::size_t>(assignment[row]);
+                    BOOST_REQUIRE_LT(col, cols);
+                    BOOST_CHECK(not used[col]);
+                    BOOST_CHECK(not std::isinf(costs[row * cols + col]));
+                    used[col] = true;
+                    ++count;
+                    total += costs[row * cols + col];
+                }
+
+                const std::pair<std::size_t, double> best = brute_force(costs, rows, cols);
+                BOOST_CHECK_EQUAL(count, best.first);
+                BOOST_CHECK_CLOSE(total + 1, best.second + 1, 1e-9);
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(matches_are_globally_optimal)
+{
+    const std::chrono::microseconds t0{1000000};
+    const std::chrono::microseconds t1{1033000};
+    vwm::memory memory{0.5f, std::chrono::milliseconds{750}};
+    memory.now(t0);
+    memory.make_observations({make_observation({"cup"}, 0.4f, 0, t0), make_observation({"cup"}, 0.9f, 0, t0)});
+    BOOST_REQUIRE_EQUAL(memory.known_objects().size(), 2);
+
+    // Matching greedily in the order of the known objects would give the first cup the observation at 0.7 and the
+    // second one the observation at 0, in total 0.3 + 0.9 instead of 0.4 + 0.2
+    memory.now(t1);
+    memory.make_observations({make_observation({"cup"}, 0.7f, 0, t1), make_observation({"cup"}, 0, 0, t1)});
+
+    const std::vector<known_object::ptr> known_objects = memory.known_objects();
+    BOOST_REQUIRE_EQUAL(known_objects.size(), 2);
+    BOOST_CHECK_EQUAL(known_objects[0]->current_observation()->cx(), 0);
+    BOOST_CHECK_CLOSE(known_objects[1]->current_observation()->cx(), 0.7f, 1e-4);
+}
+
+
+BOOST_AUTO_TEST_CASE(matches_respect_classes_and_gating)
+{
+    const std::chrono::microseconds t0{1000000};
+    const std::chrono::microseconds t1{1033000};
+    vwm::memory memory{0.5f, std::chrono::milliseconds{750}};
+    memory.match_gating_distance(0.2);
+    memory.now(t0);
+    memory.make_observations({make_observation({"cup"}, 0, 0, t0), make_observation({"bowl"}, 0.1f, 0, t0)});
+    BOOST_REQUIRE_EQUAL(memory.known_objects().size(), 2);
+
+    // The first observation may be a cup or a bowl, and is the only one close enough to the bowl.  The second one is
+    // a cup and close enough to the cup.  The third one is a cup, but too far away from the cup and becomes a new
+    // object
+    memory.now(t1);
+    const observation::ptr cup_or_bowl = make_observation({"plate", "cup", "bowl"}, 0.12f, 0, t1);
+    const observation::ptr cup = make_observation({"cup"}, 0.05f, 0, t1);
+    const observation::ptr far_cup = make_observation({"cup"}, 0.8f, 0, t1);
+    memory.make_observations({cup_or_bowl, cup, far_cup});
+
+    const std::vector<known_object::ptr> known_objects = memory.known_objects();
+    BOOST_REQUIRE_EQUAL(known_objects.size(), 3);
+    BOOST_CHECK(known_objects[0]->current_observation() == cup);
+    BOOST_CHECK(known_objects[1]->current_observation() == cup_or_bowl);
+    BOOST_CHECK(known_objects[2]->current_observation() == far_cup);
+    BOOST_CHECK_EQUAL(known_objects[2]->class_name(), "cup");
+}
+
+
+BOOST_AUTO_TEST_CASE(gated_matches_equal_the_assignment_of_all_pairs)
+{
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> position{0, 1};
+    std::normal_distribution<float> motion{0, 0.02f};
+    std::bernoulli_distribution disappears{0.1};
+    const double gating_distance = 0.08;
+
+    vwm::memory memory{0.5f, std::chrono::milliseconds{100}};
+    memory.match_gating_distance(gating_distance);
+    std::chrono::microseconds now{1000000};
+
+    // Cups moving around, disappearing for a few frames at times, with new ones appearing
+    std::vector<std::pair<float, float>> cups(60);
+    for (std::pair<float, float>& cup : cups)
+        cup = {position(rng), position(rng)};
+
+    for (int frame = 0; frame < 40; ++frame)
+    {
+        now += std::chrono::microseconds{33000};
+        memory.now(now);
+
+        std::vector<observation::ptr> observations;
+        for (std::pair<float, float>& cup : cups)
+        {
+            cup.first = std::clamp(cup.first + motion(rng), 0.f, 1.f);
+            cup.second = std::clamp(cup.second + motion(rng), 0.f, 1.f);
+            if (not disappears(rng))
+                observations.push_back(make_observation({"cup"}, cup.first, cup.second, now));
+        }
+        for (int i = 0; i < 3; ++i)
+            cups.emplace_back(position(rng), position(rng));
+
+        // Expected number of matches and their total distance, by solving the assignment of all pairs within the
+        // gating distance at once.  Cups at the border may be swapped at the same total distance
+        const std::vector<known_object::ptr> before = memory.known_objects();
+        std::vector<double> costs(before.size() * observations.size(), forbidden);
+        for (std::size_t k = 0; k < before.size(); ++k)
+        {
+            for (std::size_t o = 0; o < observations.size(); ++o)
+            {
+                const double distance = before[k]->current_observation()->distance_to(observations[o]);
+                if (distance <= gating_distance)
+                    costs[k * observations.size() + o] = distance;
+            }
+        }
+        const std::vector<int> expected = vwm::solve_assignment(costs, before.size(), observations.size());
+        double expected_distance = 0;
+        for (std::size_t k = 0; k < before.size(); ++k)
+            if (expected[k] >= 0)
+                expected_distance += costs[k * observations.size() + static_cast<std::size_t>(expected[k])];
+
+        memory.make_observations(observations);
+
+        double distance = 0;
+        std::size_t matched = 0;
+        for (std::size_t k = 0; k < before.size(); ++k)
+        {
+            if (before[k]->all_observations_forgotten()) continue;
+
+            const auto o = std::find(std::begin(observations), std::end(observations),
+                                     before[k]->current_observation());
+            if (o == std::end(observations)) continue;
+
+            const double cost = costs[k * observations.size() + static_cast<std::size_t>(o - std::begin(observations))];
+            BOOST_CHECK(not std::isinf(cost));
+            distance += cost;
+            ++matched;
+        }
+        BOOST_CHECK_EQUAL(matched, static_cast<std::size_t>(std::count_if(std::begin(expected), std::end(expected),
+                                                                          [](int o) { return o >= 0; })));
+        BOOST_CHECK_CLOSE(distance + 1, expected_distance + 1, 1e-6);
+
+        const std::vector<known_object::ptr> after = memory.known_objects();
+        const std::size_t kept = static_cast<std::size_t>(std::count_if(std::begin(before), std::end(before),
+            [&after](const known_object::ptr& object)
+        {
+            return std::find(std::begin(after), std::end(after), object) != std::end(after);
+        }));
+        BOOST_CHECK_EQUAL(after.size(), kept + observations.size() - matched);
+    }
+}
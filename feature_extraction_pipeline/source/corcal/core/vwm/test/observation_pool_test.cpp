@@ -0,0 +1,154 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::vwm::observation_pool
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <chrono>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/vwm.h>
+
+
+using namespace corcal::core;
+
+
+BOOST_AUTO_TEST_CASE(slots_are_recycled)
+{
+    const std::shared_ptr<vwm::observation_pool> pool = vwm::observation_pool::create(4);
+
+    std::set<observation*> first_slots;
+    {
+        std::vector<observation::ptr> observations;
+        for (int i = 0; i < 6; ++i)
+        {
+            observations.push_back(pool->acquire());
+            first_slots.insert(observations.back().get());
+        }
+        BOOST_CHECK_EQUAL(pool->capacity(), 8);
+        BOOST_CHECK_EQUAL(pool->in_use(), 6);
+
+        // Copies share the observation
+        const observation::ptr copy = observations[0];
+        BOOST_CHECK_EQUAL(copy.use_count(), 2);
+        BOOST_CHECK(copy == observations[0]);
+    }
+    BOOST_CHECK_EQUAL(pool->in_use(), 0);
+
+    std::vector<observation::ptr> observations;
+    for (int i = 0; i < 6; ++i)
+    {
+        observations.push_back(pool->acquire());
+        BOOST_CHECK_EQUAL(observations.back()->candidates().size(), 0);
+        BOOST_CHECK(not observations.back()->has_bounding_box_set());
+    }
+    BOOST_CHECK_EQUAL(pool->capacity(), 8);
+}
+
+
+BOOST_AUTO_TEST_CASE(recycled_candidates_keep_their_storage)
+{
+    const std::shared_ptr<vwm::observation_pool> pool = vwm::observation_pool::create(1);
+    const std::string class_name = "a class name too long for the small string optimisation";
+
+    const char* storage;
+    {
+        observation::ptr o = pool->acquire();
+        candidate c;
+        c.class_name(class_name);
+        o->candidates().push_back(c);
+        o->cx(0.5f);
+        storage = o->candidates()[0].class_name().data();
+    }
+
+    observation::ptr o = pool->acquire();
+    BOOST_CHECK_EQUAL(o->cx(), 0);
+    BOOST_CHECK(o->candidates().empty());
+
+    candidate c;
+    c.class_name(class_name);
+    o->candidates().push_back(c);
+    BOOST_CHECK_EQUAL(o->candidates().at(0).class_name(), class_name);
+    BOOST_CHECK(o->candidates()[0].class_name().data() == storage);
+}
+
+
+BOOST_AUTO_TEST_CASE(candidates_beyond_capacity_are_dropped)
+{
+    observation::ptr o = observation::create();
+    for (std::size_t i = 0; i < candidate_list::max_candidates; ++i)
+        BOOST_CHECK(o->candidates().push_back(candidate{}));
+    BOOST_CHECK(not o->candidates().push_back(candidate{}));
+    BOOST_CHECK_EQUAL(o->candidates().size(), candidate_list::max_candidates);
+    BOOST_CHECK_THROW(o->candidates().at(candidate_list::max_candidates), std::out_of_range);
+}
+
+
+BOOST_AUTO_TEST_CASE(pool_outlives_memory)
+{
+    observation::ptr o;
+    {
+        vwm::memory memory{0, std::chrono::milliseconds{750}};
+        o = memory.new_observation();
+    }
+    o->cx(0.25f);
+    BOOST_CHECK_EQUAL(o->cx(), 0.25f);
+}
+
+
+BOOST_AUTO_TEST_CASE(steady_state_tracking_does_not_grow_the_pool)
+{
+    vwm::memory memory{0, std::chrono::milliseconds{100}};
+    std::size_t capacity = 0;
+    for (int frame = 1; frame <= 100; ++frame)
+    {
+        const std::chrono::microseconds now{frame * 33333};
+        memory.now(now);
+
+        std::vector<observation::ptr> observations;
+        for (int i = 0; i < 10; ++i)
+        {
+            observation::ptr o = memory.new_observation();
+            candidate c;
+            c.class_name("class_" + std::to_string(i));
+            c.certainty(1);
+            o->candidates().push_back(c);
+            o->cx(0.05f * static_cast<float>(i));
+            o->seen_at(now);
+            observations.push_back(o);
+        }
+        memory.make_observations(observations);
+
+        if (frame == 50)
+            capacity = memory.pool().capacity();
+    }
+
+    BOOST_CHECK_EQUAL(memory.known_objects().size(), 10);
+    BOOST_CHECK_EQUAL(memory.pool().capacity(), capacity);
+}
@@ -0,0 +1,134 @@
+/*
+ * This file is part of ArmarX.
+ *
+ * ArmarX is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * ArmarX is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @package    corcal::core::vwm
+ * @author     Christian R. G. Dreher <christian.dreher@student.kit.edu>
+ * @date       2018
+ * @copyright  http://www.gnu.org/licenses/gpl-2.0.txt
+ *             GNU General Public License
+ */
+
+
+#define BOOST_TEST_MODULE corcal::test::core::vwm::spatial_grid
+#define ARMARX_BOOST_TEST
+
+
+// STD/STL
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <corcal/Test.h>
+#include <corcal/core/vwm.h>
+
+
+using namespace corcal::core;
+
+
+namespace
+{
+    known_object::ptr
+    make_known_object(float cx, float cy)
+    {
+        observation::ptr o = observation::create();
+        candidate c;
+        c.class_name("screw");
+        o->candidates().push_back(c);
+        o->cx(cx);
+        o->cy(cy);
+        return std::make_shared<known_object>(o, 1);
+    }
+
+
+    void
+    move(const known_object::ptr& object, float cx, float cy, std::chrono::microseconds seen_at)
+    {
+        observation::ptr o = observation::create();
+        o->candidates(object->current_observation()->candidates());
+        o->cx(cx);
+        o->cy(cy);
+        o->seen_at(seen_at);
+        object->remember_observation(o);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(cell_sizes_are_bounded)
+{
+    BOOST_CHECK_EQUAL(spatial_grid{0.25}.cell_size(), 0.25);
+    BOOST_CHECK_EQUAL(spatial_grid{2}.cell_size(), 2);
+    BOOST_CHECK_EQUAL(spatial_grid{0}.cell_size(), 1. / spatial_grid::max_cells_per_axis);
+    BOOST_CHECK_EQUAL(spatial_grid{0.001}.cell_size(), 1. / spatial_grid::max_cells_per_axis);
+}
+
+
+BOOST_AUTO_TEST_CASE(queries_find_all_known_objects_within_radius)
+{
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> position{0, 1};
+    std::uniform_int_distribution<int> action{0, 9};
+    const double radius = 0.1;
+
+    spatial_grid grid{radius};
+    std::vector<known_object::ptr> objects;
+    std::chrono::microseconds now{0};
+
+    for (int step = 0; step < 2000; ++step)
+    {
+        now += std::chrono::microseconds{1000};
+        const int a = action(rng);
+        if (a < 3 or objects.empty())
+        {
+            objects.push_back(make_known_object(position(rng), position(rng)));
+            grid.update(objects.back().get());
+        }
+        else if (a < 4)
+        {
+            const std::size_t erased = std::uniform_int_distribution<std::size_t>{0, objects.size() - 1}(rng);
+            grid.erase(objects[erased].get());
+            objects.erase(std::begin(objects) + static_cast<std::ptrdiff_t>(erased));
+        }
+        else
+        {
+            const std::size_t moved = std::uniform_int_distribution<std::size_t>{0, objects.size() - 1}(rng);
+            move(objects[moved], position(rng), position(rng), now);
+            grid.update(objects[moved].get());
+        }
+        BOOST_REQUIRE_EQUAL(grid.size(), objects.size());
+
+        const float cx = position(rng);
+        const float cy = position(rng);
+        std::multiset<const known_object*> found;
+        grid.for_each_near(cx, cy, radius, [&found](const known_object* object) { found.insert(object); });
+        for (const known_object::ptr& object : objects)
+        {
+            const observation::ptr current = object->current_observation();
+            const std::size_t count = found.count(object.get());
+            BOOST_CHECK_LE(count, 1);
+            if (std::hypot(current->cx() - cx, current->cy() - cy) <= radius)
+                BOOST_CHECK_EQUAL(count, 1);
+        }
+    }
+
+    grid.clear();
+    BOOST_CHECK_EQUAL(grid.size(), 0);
+    std::size_t found = 0;
+    grid.for_each_near(0.5f, 0.5f, 1, [&found](const known_object*) { ++found; });
+    BOOST_CHECK_EQUAL(found, 0);
+}
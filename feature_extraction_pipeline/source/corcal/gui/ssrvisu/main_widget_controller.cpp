@@ -24,6 +24,9 @@
 #include <corcal/gui/ssrvisu/main_widget_controller.h>
 
 
+// STD/STL
+#include <string_view>
+
 // Boost
 #include <boost/algorithm/string.hpp>
 
@@ -31,6 +34,40 @@
 #include <corcal/gui/ssrvisu/ui_main_widget.h>
 
 
+namespace
+{
+    /**
+     * @brief Filter entry which matches everything
+     */
+    const QString any = "(any)";
+
+
+    QString
+    to_qstring(std::string_view string)
+    {
+        return QString::fromUtf8(string.data(), static_cast<int>(string.size()));
+    }
+
+
+    /**
+     * @brief Replaces the entries of the filter after the "any" entry, keeping the selection if still available
+     */
+    void
+    reset_filter(QComboBox* filter, const std::vector<std::string>& entries)
+    {
+        const QString selection = filter->currentText();
+
+        filter->clear();
+        filter->addItem(::any);
+        for (const std::string& entry : entries)
+            filter->addItem(QString::fromStdString(entry));
+
+        const int index = filter->findText(selection);
+        filter->setCurrentIndex(index >= 0 ? index : 0);
+    }
+}
+
+
 const std::string
 corcal::gui::ssrvisu::main_widget_controller::widget_name = "SSR feature visualisation";
 
@@ -40,6 +77,17 @@ corcal::gui::ssrvisu::main_widget_controller::main_widget_controller() :
 {
     // Initialise widget
     widget->setupUi(getWidget());
+
+    widget->relation_filter->addItem(::any);
+    for (const corcal::core::ssr::relation_schema_entry& entry : corcal::core::ssr::relation_schema)
+        widget->relation_filter->addItem(::to_qstring(entry.name));
+
+    ::reset_filter(widget->subject_filter, m_instance_names);
+    ::reset_filter(widget->object_filter, m_instance_names);
+
+    // Deltas arrive in an Ice thread, the view may only be updated in the GUI thread
+    connect(this, SIGNAL(ssr_features_changed()), this, SLOT(update_relations_view()), Qt::QueuedConnection);
+    connect(widget->button_filter, SIGNAL(clicked()), this, SLOT(update_relations_view()));
 }
 
 
@@ -87,7 +135,7 @@ corcal::gui::ssrvisu::main_widget_controller::saveSettings(QSettings*)
 void
 corcal::gui::ssrvisu::main_widget_controller::onInitComponent()
 {
-    usingTopic("SSRFeatures"); // TODO: Make configurable
+    usingTopic(getProperty<std::string>("ssr_delta_topic"));
 }
 
 
@@ -114,3 +162,89 @@ corcal::gui::ssrvisu::main_widget_controller::ssr_features_detected(
 {
     // pass
 }
+
+
+void
+corcal::gui::ssrvisu::main_widget_controller::ssr_delta_detected(
+    const corcal::core::ssr_delta& delta,
+    const Ice::Current&)
+{
+    {
+        const std::lock_guard<std::mutex> lock{m_ssr_mutex};
+
+        if (not m_ssr_delta_decoder.apply(delta))
+        {
+            ARMARX_DEBUG << "Waiting for the next SSR keyframe";
+            return;
+        }
+    }
+
+    emit ssr_features_changed();
+}
+
+
+void
+corcal::gui::ssrvisu::main_widget_controller::update_relations_view()
+{
+    const std::lock_guard<std::mutex> lock{m_ssr_mutex};
+
+    if (not m_ssr_delta_decoder.synchronised())
+        return;
+
+    const std::vector<corcal::core::detected_object>& objects = m_ssr_delta_decoder.objects();
+    const corcal::core::ssr::ssr_matrix& ssr_matrix = m_ssr_delta_decoder.matrix();
+
+    // Only offer other instances in the filters if objects appeared or disappeared
+    std::vector<std::string> instance_names;
+    instance_names.reserve(objects.size());
+    for (const corcal::core::detected_object& object : objects)
+        instance_names.push_back(object.instance_name);
+
+    if (instance_names != m_instance_names)
+    {
+        m_instance_names = std::move(instance_names);
+        ::reset_filter(widget->subject_filter, m_instance_names);
+        ::reset_filter(widget->object_filter, m_instance_names);
+    }
+
+    const QString subject_filter = widget->subject_filter->currentText();
+    const QString relation_filter = widget->relation_filter->currentText();
+    const QString object_filter = widget->object_filter->currentText();
+
+    widget->relations_view->setRowCount(0);
+    for (std::size_t i = 0; i < objects.size(); ++i) for (std::size_t j = 0; j < objects.size(); ++j)
+    {
+        const QString subject = QString::fromStdString(objects[i].instance_name);
+        const QString object = QString::fromStdString(objects[j].instance_name);
+
+        if (i == j or (subject_filter != ::any and subject != subject_filter)
+            or (object_filter != ::any and object != object_filter))
+            continue;
+
+        for (const std::string_view name : ssr_matrix(i, j).names())
+        {
+            const QString relation = ::to_qstring(name);
+            if (relation_filter != ::any and relation != relation_filter)
+                continue;
+
+            const int row = widget->relations_view->rowCount();
+            widget->relations_view->insertRow(row);
+            widget->relations_view->setItem(row, 0, new QTableWidgetItem{subject});
+            widget->relations_view->setItem(row, 1, new QTableWidgetItem{relation});
+            widget->relations_view->setItem(row, 2, new QTableWidgetItem{object});
+        }
+    }
+}
+
+
+armarx::PropertyDefinitionsPtr
+corcal::gui::ssrvisu::main_widget_controller::createPropertyDefinitions()
+{
+    armarx::PropertyDefinitionsPtr defs{new armarx::ComponentPropertyDefinitions{getConfigIdentifier()}};
+
+    defs->defineOptionalProperty<std::string>("ssr_delta_topic", "corcal_ssr_deltas",
+        "Topic name where the delta-encoded SSR features are published"
+    );
+
+    return defs;
+}
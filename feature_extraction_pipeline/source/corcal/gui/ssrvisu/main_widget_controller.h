@@ -26,7 +26,9 @@
 
 // STD/STL
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 // Qt
 #include <QtCore/QString>
@@ -36,7 +38,8 @@
 #include <ArmarXGui/libraries/ArmarXGuiBase/ArmarXComponentWidgetController.h>
 
 // corcal
-#include <corcal/components/ssrfeatex/ssr_feature_listener.h>
+#include <corcal/core/ssr/delta_stream.h>
+#include <corcal/interface/ssr_feature_listener.h>
 
 
 namespace Ui
@@ -59,7 +62,8 @@ namespace corcal
 
 class corcal::gui::ssrvisu::main_widget_controller:
     public armarx::ArmarXComponentWidgetController,
-    public corcal::components::ssrfeatex::ssr_feature_listener
+    public corcal::components::ssrfeatex::ssr_feature_listener,
+    public corcal::components::ssrfeatex::ssr_delta_listener
 {
 
     Q_OBJECT
@@ -72,6 +76,21 @@ class corcal::gui::ssrvisu::main_widget_controller:
 
         std::unique_ptr<Ui::main_widget> widget;
 
+        /**
+         * @brief Guards the reconstructed SSR features
+         */
+        std::mutex m_ssr_mutex;
+
+        /**
+         * @brief Reconstructs the full SSR features from the delta topic
+         */
+        corcal::core::ssr::delta_decoder m_ssr_delta_decoder;
+
+        /**
+         * @brief Instance names currently offered in the subject and object filters
+         */
+        std::vector<std::string> m_instance_names;
+
     public:
 
         main_widget_controller();
@@ -101,16 +120,28 @@ class corcal::gui::ssrvisu::main_widget_controller:
             const Ice::Current&
         ) override;
 
+        virtual void ssr_delta_detected(
+            const corcal::core::ssr_delta& delta,
+            const Ice::Current&
+        ) override;
+
     protected:
 
-        // pass
+        virtual armarx::PropertyDefinitionsPtr createPropertyDefinitions() override;
 
     public slots:
 
-        // pass
+        /**
+         * @brief Shows the relations of the reconstructed SSR features which match the subject, relation and object
+         *        filters
+         */
+        void update_relations_view();
 
     signals:
 
-        // pass
+        /**
+         * @brief Emitted from the Ice thread whenever a delta was applied, to update the view in the GUI thread
+         */
+        void ssr_features_changed();
 
 };